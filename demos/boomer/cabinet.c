@@ -12,13 +12,17 @@
 #include "sokol_time.h"
 #include "stb/stb_image.h"
 
+#include "arena.h"
 #include "cmath.h"
 #include "textured.glsl.h"
 #include "world_builder.h"
 
+#define FRAME_ARENA_BLOCK_SIZE (256 * 1024)
+
 static struct {
     void (*init_cb)();
     void (*update_cb)();
+    Cab_Arena *frame_arena;
 } globals;
 
 static struct {
@@ -30,20 +34,26 @@ static struct {
 } state;
 
 float vertices[5 * 36 * 1000 * 50]; // space for 50k cubes
-WorldBuilder builder = {vertices, 0, sizeof(vertices) / sizeof(float)};
+WorldBuilder builder = {vertices, 0, sizeof(vertices)};
 
 static void fetch_callback(const sfetch_response_t *fetch);
 
 void create_world() {
-    world_builder_init(&builder, vertices, sizeof(vertices) / sizeof(float));
+    world_builder_init(&builder, vertices, sizeof(vertices) / (VERTEX_STRIDE * sizeof(float)));
 
     world_builder_add_cube(&builder, (vec3){0.0f, 0.0f, 0.0f}, 4.0f, 0, 0, 0, 0,
                            0, 0);
 }
 
+Cab_Arena *cab_frame_arena() {
+    return globals.frame_arena;
+}
+
 static void init() {
     stm_setup();
 
+    globals.frame_arena = cab_arena_create_growable_tagged(FRAME_ARENA_BLOCK_SIZE, CAB_MEM_TAG_FRAME);
+
     sg_setup(&(sg_desc){
         .environment = sglue_environment(),
         .logger.func = slog_func,
@@ -160,9 +170,16 @@ static void fetch_callback(const sfetch_response_t *fetch) {
 }
 
 static void update() {
+    cab_arena_reset(globals.frame_arena);
     sfetch_dowork();
 
     sdtx_printf("Hello, Cabinet!\n");
+    for (int i = 0; i < CAB_MEM_TAG_COUNT; i++) {
+        Cab_Mem_Tag_Stats stats = cab_mem_tag_stats((Cab_Mem_Tag)i);
+        if (stats.peak > 0) {
+            sdtx_printf("%s: %zu KB (peak %zu KB)\n", cab_mem_tag_name((Cab_Mem_Tag)i), stats.current / 1024, stats.peak / 1024);
+        }
+    }
 
     vs_params_t vs_params;
     const float w = 1920 /5;
@@ -174,13 +191,16 @@ static void update() {
     mat4 view =
         mat4_look_at((vec3){0.0f, 0.0f, -20.0f}, (vec3){0.0f, 0.0f, 0.0f},
                      (vec3){0.0f, 1.0f, 0.0f});
-    mat4 model = mat4_rotate_y(mat4_rotate_x(mat4_create(), state.rx), state.ry);
+    transform model_transform = transform_identity();
+    model_transform.rotation = quat_multiply(quat_from_axis_angle((vec3){1.0f, 0.0f, 0.0f}, state.rx),
+                                             quat_from_axis_angle((vec3){0.0f, 1.0f, 0.0f}, state.ry));
+    mat4 model = mat4_from_transform(model_transform);
     vs_params.mvp = mat4_multiply(mat4_multiply(proj, view), model);
     
     sg_update_buffer(
         state.bind.vertex_buffers[0],
         &(sg_range){.ptr = vertices,
-                    .size = builder.current_index * sizeof(float)});
+                    .size = builder.size});
 
     sg_begin_pass(&(sg_pass){.action = state.pass_action,
                              .swapchain = sglue_swapchain()});
@@ -206,6 +226,21 @@ void cleanup() {
     sdtx_shutdown();
     sfetch_shutdown();
     sg_shutdown();
+    cab_arena_destroy(globals.frame_arena);
+}
+
+// Append one row per memory tag to memory.csv, so growth can be compared across dumps
+static void dump_memory_stats() {
+    FILE *file = fopen("memory.csv", "a");
+    if (!file) {
+        return;
+    }
+    fseek(file, 0, SEEK_END);
+    if (ftell(file) == 0) {
+        cab_mem_write_csv_header(file);
+    }
+    cab_mem_write_csv(file, sapp_frame_count());
+    fclose(file);
 }
 
 void handle_event(const sapp_event *event) {
@@ -213,6 +248,9 @@ void handle_event(const sapp_event *event) {
         if (event->key_code == SAPP_KEYCODE_ESCAPE) {
             sapp_request_quit();
         }
+        if (event->key_code == SAPP_KEYCODE_F2) {
+            dump_memory_stats();
+        }
     }
     if (event->type == SAPP_EVENTTYPE_MOUSE_MOVE) {
 //        state.rx += event->mouse_dx * 0.01f;
@@ -2,11 +2,15 @@
 #define CABINET_H
 
 #include "sokol_app.h"
+#include "arena.h"
 
 typedef struct Cab_Cabinet {
     char *name;
 } Cab_Cabinet;
 
 sapp_desc cab_sokol_main(int argc, char* argv[], Cab_Cabinet *cabinet, void (*init_cb)(), void (*update_cb)());
+
+// Scratch arena for per-frame temporaries. It is reset at the start of every frame
+Cab_Arena *cab_frame_arena();
  
 #endif // CABINET_H
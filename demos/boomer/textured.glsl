@@ -16,6 +16,76 @@ void main() {
 }
 @end
 
+// Decodes Packed_Vertex from world_builder.h: fixed point position relative to the
+// mesh origin, and the atlas tile plus quad corner instead of a texture coordinate.
+// Quads with a face set take their texture coordinate from the position instead, so
+// the tile repeats once per unit across merged faces
+@vs vs_packed
+layout(binding=0) uniform vs_packed_params {
+    mat4 mvp;
+    vec4 origin_scale; // xyz: mesh origin, w: 1 / PACKED_POSITION_SCALE
+};
+
+in ivec4 a_packed;
+
+out vec2 v_texcoord;
+flat out vec2 v_tile;
+
+// Texture axes of the front, back, left, right, top and bottom faces
+const vec3 face_u[6] = vec3[](vec3(1, 0, 0), vec3(-1, 0, 0), vec3(0, 0, 1), vec3(0, 0, -1), vec3(1, 0, 0), vec3(1, 0, 0));
+const vec3 face_v[6] = vec3[](vec3(0, -1, 0), vec3(0, -1, 0), vec3(0, -1, 0), vec3(0, -1, 0), vec3(0, 0, 1), vec3(0, 0, -1));
+
+void main() {
+    vec3 pos = vec3(a_packed.xyz) * origin_scale.w;
+    gl_Position = mvp * vec4(pos + origin_scale.xyz, 1.0);
+    int tile = a_packed.w & 255;
+    int corner = (a_packed.w >> 8) & 3;
+    int face = (a_packed.w >> 10) & 7;
+    if (face == 0) {
+        v_texcoord = vec2(float(corner == 1 || corner == 2), float(corner >= 2));
+    } else {
+        v_texcoord = vec2(dot(pos, face_u[face - 1]), dot(pos, face_v[face - 1]));
+    }
+    v_tile = vec2(float(tile & 15), float(tile >> 4));
+}
+@end
+
+// vs_packed with the surface displaced by two travelling waves. The mesh is uploaded once
+// and only the time in wave.x changes per frame. Waves are evaluated at the world position
+// of each vertex, so the shared corners of neighbouring tiles move together
+@vs vs_waves
+layout(binding=0) uniform vs_waves_params {
+    mat4 mvp;
+    vec4 origin_scale; // xyz: mesh origin, w: 1 / PACKED_POSITION_SCALE
+    vec4 wave;         // x: time in seconds, y: amplitude, z: frequency per unit, w: speed
+};
+
+in ivec4 a_packed;
+
+out vec2 v_texcoord;
+flat out vec2 v_tile;
+
+const vec3 face_u[6] = vec3[](vec3(1, 0, 0), vec3(-1, 0, 0), vec3(0, 0, 1), vec3(0, 0, -1), vec3(1, 0, 0), vec3(1, 0, 0));
+const vec3 face_v[6] = vec3[](vec3(0, -1, 0), vec3(0, -1, 0), vec3(0, -1, 0), vec3(0, -1, 0), vec3(0, 0, 1), vec3(0, 0, -1));
+
+void main() {
+    vec3 pos = vec3(a_packed.xyz) * origin_scale.w;
+    vec3 world = pos + origin_scale.xyz;
+    float phase = wave.x * wave.w;
+    world.y += wave.y * (sin(world.x * wave.z + phase) + cos(world.z * wave.z + phase * 1.2));
+    gl_Position = mvp * vec4(world, 1.0);
+    int tile = a_packed.w & 255;
+    int corner = (a_packed.w >> 8) & 3;
+    int face = (a_packed.w >> 10) & 7;
+    if (face == 0) {
+        v_texcoord = vec2(float(corner == 1 || corner == 2), float(corner >= 2));
+    } else {
+        v_texcoord = vec2(dot(pos, face_u[face - 1]), dot(pos, face_v[face - 1]));
+    }
+    v_tile = vec2(float(tile & 15), float(tile >> 4));
+}
+@end
+
 @fs fs
 in vec2 v_texcoord;
 out vec4 frag_color;
@@ -27,4 +97,19 @@ void main() {
 }
 @end
 
+// Wraps v_texcoord inside the 16x16 atlas tile v_tile
+@fs fs_tiled
+in vec2 v_texcoord;
+flat in vec2 v_tile;
+out vec4 frag_color;
+layout(binding=0) uniform texture2D tex;
+layout(binding=0) uniform sampler smp;
+
+void main() {
+    frag_color = texture(sampler2D(tex, smp), (v_tile + fract(v_texcoord)) / 16.0);
+}
+@end
+
 @program textured vs fs
+@program textured_packed vs_packed fs_tiled
+@program textured_waves vs_waves fs_tiled
@@ -0,0 +1,238 @@
+#include "sokol_gfx.h"
+#include "chunk_world.h"
+#include <string.h>
+
+#define CHUNK_STAGING_VERTICES (CHUNK_MAX_QUADS * QUAD_VERTICES)
+#define CHUNK_MIN_BUFFER_VERTICES 1024
+
+void chunk_world_init(ChunkWorld* world, Cab_Arena* arena, int chunks_x, int chunks_y, int chunks_z, vec3 origin) {
+    *world = (ChunkWorld){
+        .chunks_x = chunks_x,
+        .chunks_y = chunks_y,
+        .chunks_z = chunks_z,
+        .size_x = chunks_x * CHUNK_SIZE,
+        .size_y = chunks_y * CHUNK_SIZE,
+        .size_z = chunks_z * CHUNK_SIZE,
+        .chunk_count = chunks_x * chunks_y * chunks_z,
+        .origin = origin,
+    };
+    world->chunks = cab_arena_alloc(arena, world->chunk_count * sizeof(Chunk));
+    world->dirty = cab_arena_alloc(arena, world->chunk_count * sizeof(uint32_t));
+    world->scratch = cab_arena_alloc(arena, CAB_MAX_THREADS * sizeof(Chunk_Scratch));
+    world->meshes = cab_arena_alloc(arena, world->chunk_count * sizeof(Chunk_Mesh));
+    memset(world->scratch, 0, CAB_MAX_THREADS * sizeof(Chunk_Scratch));
+
+    for (int cy = 0; cy < chunks_y; cy++) {
+        for (int cz = 0; cz < chunks_z; cz++) {
+            for (int cx = 0; cx < chunks_x; cx++) {
+                uint32_t index = (uint32_t)VOXEL_INDEX(chunks_x, chunks_z, cx, cy, cz);
+                Chunk* chunk = &world->chunks[index];
+                memset(chunk, 0, sizeof(Chunk));
+                chunk->origin = vec3_add(origin, (vec3){cx * CHUNK_SIZE, cy * CHUNK_SIZE, cz * CHUNK_SIZE});
+                chunk->dirty = true;
+                world->dirty[world->dirty_count++] = index;
+            }
+        }
+    }
+}
+
+void chunk_world_shutdown(ChunkWorld* world) {
+    for (int i = 0; i < world->chunk_count; i++) {
+        if (world->chunks[i].buffer_vertices > 0) {
+            sg_destroy_buffer(world->chunks[i].vertex_buffer);
+        }
+    }
+    *world = (ChunkWorld){0};
+}
+
+static bool in_world(const ChunkWorld* world, int x, int y, int z) {
+    return x >= 0 && y >= 0 && z >= 0 && x < world->size_x && y < world->size_y && z < world->size_z;
+}
+
+uint8_t chunk_world_get_block(const ChunkWorld* world, int x, int y, int z) {
+    if (!in_world(world, x, y, z)) {
+        return VOXEL_AIR;
+    }
+    const Chunk* chunk = &world->chunks[VOXEL_INDEX(world->chunks_x, world->chunks_z, x / CHUNK_SIZE, y / CHUNK_SIZE, z / CHUNK_SIZE)];
+    return chunk->blocks[VOXEL_INDEX(CHUNK_SIZE, CHUNK_SIZE, x % CHUNK_SIZE, y % CHUNK_SIZE, z % CHUNK_SIZE)];
+}
+
+static void mark_dirty(ChunkWorld* world, int cx, int cy, int cz) {
+    if (cx < 0 || cy < 0 || cz < 0 || cx >= world->chunks_x || cy >= world->chunks_y || cz >= world->chunks_z) {
+        return;
+    }
+    uint32_t index = (uint32_t)VOXEL_INDEX(world->chunks_x, world->chunks_z, cx, cy, cz);
+    if (!world->chunks[index].dirty) {
+        world->chunks[index].dirty = true;
+        world->dirty[world->dirty_count++] = index;
+    }
+}
+
+void chunk_world_set_block(ChunkWorld* world, int x, int y, int z, uint8_t block) {
+    if (!in_world(world, x, y, z)) {
+        return;
+    }
+    int cx = x / CHUNK_SIZE, cy = y / CHUNK_SIZE, cz = z / CHUNK_SIZE;
+    int lx = x % CHUNK_SIZE, ly = y % CHUNK_SIZE, lz = z % CHUNK_SIZE;
+    uint8_t* slot = &world->chunks[VOXEL_INDEX(world->chunks_x, world->chunks_z, cx, cy, cz)].blocks[VOXEL_INDEX(CHUNK_SIZE, CHUNK_SIZE, lx, ly, lz)];
+    if (*slot == block) {
+        return;
+    }
+    *slot = block;
+    mark_dirty(world, cx, cy, cz);
+
+    // A block on the chunk border hides or exposes a face of the block across it
+    if (lx == 0) {
+        mark_dirty(world, cx - 1, cy, cz);
+    }
+    if (lx == CHUNK_SIZE - 1) {
+        mark_dirty(world, cx + 1, cy, cz);
+    }
+    if (ly == 0) {
+        mark_dirty(world, cx, cy - 1, cz);
+    }
+    if (ly == CHUNK_SIZE - 1) {
+        mark_dirty(world, cx, cy + 1, cz);
+    }
+    if (lz == 0) {
+        mark_dirty(world, cx, cy, cz - 1);
+    }
+    if (lz == CHUNK_SIZE - 1) {
+        mark_dirty(world, cx, cy, cz + 1);
+    }
+}
+
+// Copy the chunk blocks and the neighbour blocks around them into bordered
+static void gather_bordered(const ChunkWorld* world, const Chunk* chunk, uint8_t* bordered) {
+    int base_x = (int)(chunk->origin.x - world->origin.x) - 1;
+    int base_y = (int)(chunk->origin.y - world->origin.y) - 1;
+    int base_z = (int)(chunk->origin.z - world->origin.z) - 1;
+    for (int y = 0; y < CHUNK_BORDERED_SIZE; y++) {
+        for (int z = 0; z < CHUNK_BORDERED_SIZE; z++) {
+            uint8_t* row = bordered + VOXEL_INDEX(CHUNK_BORDERED_SIZE, CHUNK_BORDERED_SIZE, 0, y, z);
+            bool inner = y > 0 && z > 0 && y <= CHUNK_SIZE && z <= CHUNK_SIZE;
+            if (inner) {
+                // Rows inside the chunk come straight from its blocks, only the ends need lookups
+                memcpy(row + 1, chunk->blocks + VOXEL_INDEX(CHUNK_SIZE, CHUNK_SIZE, 0, y - 1, z - 1), CHUNK_SIZE);
+                row[0] = chunk_world_get_block(world, base_x, base_y + y, base_z + z);
+                row[CHUNK_SIZE + 1] = chunk_world_get_block(world, base_x + CHUNK_SIZE + 1, base_y + y, base_z + z);
+                continue;
+            }
+            for (int x = 0; x < CHUNK_BORDERED_SIZE; x++) {
+                row[x] = chunk_world_get_block(world, base_x + x, base_y + y, base_z + z);
+            }
+        }
+    }
+}
+
+// Mesh one chunk into staging, returns the vertices written
+static size_t mesh_chunk(const ChunkWorld* world, const Chunk* chunk, Packed_Vertex* staging, uint8_t* bordered) {
+    gather_bordered(world, chunk, bordered);
+    WorldBuilder builder;
+    world_builder_init_packed(&builder, staging, CHUNK_STAGING_VERTICES, chunk->origin);
+    world_builder_voxels_greedy_bordered(&builder, bordered, CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE, chunk->origin, 1.0f);
+    return world_builder_get_vertex_count(&builder);
+}
+
+// Upload a finished mesh, growing the vertex buffer to the next power of two when it is too small
+static void upload_chunk(Chunk* chunk, const Packed_Vertex* vertices, size_t vertex_count) {
+    chunk->element_count = vertex_count / QUAD_VERTICES * QUAD_INDICES;
+    if (vertex_count == 0) {
+        return;
+    }
+    if (vertex_count > chunk->buffer_vertices) {
+        if (chunk->buffer_vertices > 0) {
+            sg_destroy_buffer(chunk->vertex_buffer);
+        }
+        size_t capacity = CHUNK_MIN_BUFFER_VERTICES;
+        while (capacity < vertex_count) {
+            capacity *= 2;
+        }
+        chunk->vertex_buffer = sg_make_buffer(&(sg_buffer_desc){
+            .size = capacity * sizeof(Packed_Vertex),
+            .type = SG_BUFFERTYPE_VERTEXBUFFER,
+            .usage = SG_USAGE_DYNAMIC,
+            .label = "chunk-vertices",
+        });
+        chunk->buffer_vertices = capacity;
+    }
+    sg_update_buffer(chunk->vertex_buffer, &(sg_range){vertices, vertex_count * sizeof(Packed_Vertex)});
+}
+
+// Worker side: mesh the chunk in dirty slot into the thread's scratch, then copy the result
+// into its arena and publish it. Only reads the world, so chunks mesh independently
+static void mesh_dirty_chunk(uint32_t slot, void* user) {
+    ChunkWorld* world = (ChunkWorld*)user;
+    Cab_Arena* arena = cab_thread_arena();
+    if (!arena) {
+        return; // Registry full, the chunk stays dirty and is retried next update
+    }
+    Chunk_Scratch* scratch = &world->scratch[cab_thread_index()];
+    if (!scratch->staging) {
+        scratch->staging = cab_arena_alloc(arena, CHUNK_STAGING_VERTICES * sizeof(Packed_Vertex));
+        scratch->bordered = cab_arena_alloc(arena, CHUNK_BORDERED_SIZE * CHUNK_BORDERED_SIZE * CHUNK_BORDERED_SIZE);
+    }
+
+    size_t vertex_count = mesh_chunk(world, &world->chunks[world->dirty[slot]], scratch->staging, scratch->bordered);
+    Chunk_Mesh* mesh = cab_arena_alloc(arena, sizeof(Chunk_Mesh));
+    *mesh = (Chunk_Mesh){.dirty_slot = slot, .vertex_count = vertex_count};
+    if (vertex_count > 0) {
+        mesh->vertices = cab_arena_alloc(arena, vertex_count * sizeof(Packed_Vertex));
+        memcpy(mesh->vertices, scratch->staging, vertex_count * sizeof(Packed_Vertex));
+    }
+    cab_thread_publish(mesh, sizeof(Chunk_Mesh));
+}
+
+static void collect_mesh(uint32_t thread_index, void* data, size_t size, void* user) {
+    (void)thread_index;
+    (void)size;
+    ChunkWorld* world = (ChunkWorld*)user;
+    Chunk_Mesh* mesh = (Chunk_Mesh*)data;
+    world->meshes[mesh->dirty_slot] = *mesh;
+}
+
+int chunk_world_update(ChunkWorld* world, Cab_Worker_Pool* pool) {
+    int count = world->dirty_count;
+    if (count == 0) {
+        return 0;
+    }
+    for (int i = 0; i < count; i++) {
+        world->meshes[i] = (Chunk_Mesh){.dirty_slot = UINT32_MAX};
+    }
+    if (pool) {
+        cab_worker_pool_for(pool, (uint32_t)count, mesh_dirty_chunk, world);
+    } else {
+        for (int i = 0; i < count; i++) {
+            mesh_dirty_chunk((uint32_t)i, world);
+        }
+    }
+    cab_thread_arenas_collect(collect_mesh, world);
+
+    // Upload in dirty list order, chunks that could not be meshed stay queued
+    int remeshed = 0;
+    int still_dirty = 0;
+    for (int i = 0; i < count; i++) {
+        Chunk_Mesh* mesh = &world->meshes[i];
+        Chunk* chunk = &world->chunks[world->dirty[i]];
+        if (mesh->dirty_slot == UINT32_MAX) {
+            world->dirty[still_dirty++] = world->dirty[i];
+            continue;
+        }
+        upload_chunk(chunk, mesh->vertices, mesh->vertex_count);
+        chunk->dirty = false;
+        remeshed++;
+    }
+    world->dirty_count = still_dirty;
+
+    cab_thread_arenas_reset();
+    memset(world->scratch, 0, CAB_MAX_THREADS * sizeof(Chunk_Scratch));
+    return remeshed;
+}
+
+size_t chunk_world_element_count(const ChunkWorld* world) {
+    size_t count = 0;
+    for (int i = 0; i < world->chunk_count; i++) {
+        count += world->chunks[i].element_count;
+    }
+    return count;
+}
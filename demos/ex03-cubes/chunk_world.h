@@ -0,0 +1,81 @@
+#ifndef CHUNK_WORLD_H
+#define CHUNK_WORLD_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "cmath.h"
+#include "thread_arena.h"
+#include "worker_pool.h"
+#include "world_builder.h"
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before chunk_world.h"
+#endif
+
+#define CHUNK_SIZE 16
+#define CHUNK_BLOCKS (CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE)
+#define CHUNK_BORDERED_SIZE (CHUNK_SIZE + 2)
+// A checkerboard of blocks exposes every face of half the blocks
+#define CHUNK_MAX_QUADS (CHUNK_BLOCKS / 2 * 6)
+
+// A block of the world with its own greedy mesh and vertex buffer. Vertices are
+// Packed_Vertex relative to origin, so each chunk is drawn with its own origin uniform
+typedef struct {
+    uint8_t blocks[CHUNK_BLOCKS]; // VOXEL_INDEX order, see world_builder.h
+    vec3 origin;                  // World position of block (0, 0, 0)
+    sg_buffer vertex_buffer;      // Invalid while the chunk has never had any faces
+    size_t buffer_vertices;       // Capacity of vertex_buffer
+    size_t element_count;         // Indices to draw with the shared quad index buffer
+    bool dirty;                   // Queued for remeshing
+} Chunk;
+
+// Meshing memory of one thread, allocated from its thread arena on first use in an update
+typedef struct {
+    Packed_Vertex* staging; // Vertex memory for meshing one chunk
+    uint8_t* bordered;      // Chunk blocks plus a one block border from the neighbours
+} Chunk_Scratch;
+
+// Finished mesh of a dirty chunk, published by the thread that meshed it
+typedef struct {
+    uint32_t dirty_slot;     // Position in the dirty list
+    Packed_Vertex* vertices; // In the meshing thread's arena
+    size_t vertex_count;
+} Chunk_Mesh;
+
+// Fixed grid of chunks. Editing a block only queues its chunk, plus the neighbours whose
+// border faces it can hide or expose, so chunk_world_update work scales with the edits
+typedef struct {
+    int chunks_x, chunks_y, chunks_z;
+    int size_x, size_y, size_z; // World size in blocks
+    int chunk_count;
+    vec3 origin;                // World position of block (0, 0, 0)
+    Chunk* chunks;              // x fastest, then z, then y, like blocks
+    uint32_t* dirty;            // Chunks queued for remeshing, in the order they were edited
+    int dirty_count;
+    Chunk_Scratch* scratch;     // Indexed by cab_thread_index()
+    Chunk_Mesh* meshes;         // Indexed by dirty slot while updating
+} ChunkWorld;
+
+// Allocates the chunks and meshing scratch from arena. Every chunk starts empty and dirty
+void chunk_world_init(ChunkWorld* world, Cab_Arena* arena, int chunks_x, int chunks_y, int chunks_z, vec3 origin);
+// Destroys the vertex buffers, the memory goes away with the arena
+void chunk_world_shutdown(ChunkWorld* world);
+
+// Block coordinates count from the world origin. Outside the world everything is air
+uint8_t chunk_world_get_block(const ChunkWorld* world, int x, int y, int z);
+// Writes are ignored outside the world or when the block does not change
+void chunk_world_set_block(ChunkWorld* world, int x, int y, int z, uint8_t block);
+
+// Remesh every dirty chunk and upload its vertices. Chunks are meshed in parallel on pool,
+// or on the calling thread when pool is NULL, each into its thread's arena. Uploads then
+// happen on the calling thread in dirty list order, so the result never depends on which
+// thread meshed what. This is a sync point for the thread arenas: published results are
+// collected and every thread arena is reset before returning. Call at most once per frame,
+// since a dynamic buffer can only be updated once per frame. Returns the number of chunks remeshed
+int chunk_world_update(ChunkWorld* world, Cab_Worker_Pool* pool);
+
+// Totals over all chunks, for the HUD
+size_t chunk_world_element_count(const ChunkWorld* world);
+
+#endif // CHUNK_WORLD_H
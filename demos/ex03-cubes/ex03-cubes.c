@@ -10,16 +10,24 @@
 #include "sokol_time.h"
 #include "stb_image.h"
 
+#include "arena.h"
+#include "chunk_world.h"
 #include "cmath.h"
+#include "terrain.h"
 #include "textured.glsl.h"
 #include "world_builder.h"
 
+#include <assert.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 static struct {
     float rx;
     float ry;
     sg_pipeline pip;
+    sg_pipeline waves_pip;
+    sg_buffer waves_buffer;
     sg_bindings bind;
     sg_pass_action pass_action;
     uint8_t file_buffer[1024 * 256];
@@ -39,18 +47,201 @@ static void printf_wrapper(const char *fmt, ...) {
     va_end(args);
 }
 
-float vertices[5 * 36 * 1000 * 50]; // space for 50k cubes
-WorldBuilder builder = { vertices, 0, sizeof(vertices) / sizeof(float) };
+#define MAX_VERTICES (36 * 1000 * 50) // space for 50k cubes
+#define MAX_QUADS (MAX_VERTICES / QUAD_INDICES)
+#define WORLD_ARENA_RESERVE ((size_t)1 << 30)
+#define VOXEL_SIZE_X 40
+#define VOXEL_SIZE_Y 16
+#define VOXEL_SIZE_Z 40
+#define WORLD_CHUNKS_X 4
+#define WORLD_CHUNKS_Y 2
+#define WORLD_CHUNKS_Z 4
+#define TERRAIN_SIZE 256.0f
+#define TERRAIN_LEVELS 5          // Leaf tiles of TERRAIN_SIZE / 16 / 2^4 = 1 unit
+#define TERRAIN_LOD_DISTANCE 1.5f
+#define WAVES_TILE_SIZE 0.5f
+#define WAVES_AMPLITUDE 1.0f
+#define WAVES_FREQUENCY 0.3f // Radians per unit
+#define WAVES_SPEED 1.5f     // Radians per second
+
+// Vertex memory comes from a reserved address range instead of a 36 MB static array
+Cab_Arena *world_arena;
+Packed_Vertex *vertices;
+WorldBuilder builder;
+
+// V cycles through the terrain meshes
+typedef enum {
+    WORLD_HEIGHTMAP,
+    WORLD_VOXELS,        // One quad per exposed block face
+    WORLD_VOXELS_GREEDY, // Exposed faces merged into larger quads
+    WORLD_CHUNKS,        // Chunked voxel world, edited every frame
+    WORLD_TERRAIN,       // Quadtree terrain, level of detail picked by camera distance
+    WORLD_WAVES,         // Static heightmap animated in the vertex shader
+    WORLD_MODE_COUNT,
+} World_Mode;
+
+static const char *world_mode_names[WORLD_MODE_COUNT] = {"heightmap", "voxels", "greedy voxels", "chunks", "lod terrain", "waves"};
+
+uint8_t voxels[VOXEL_SIZE_X * VOXEL_SIZE_Y * VOXEL_SIZE_Z];
+vec3 voxel_origin = {-VOXEL_SIZE_X / 2, -VOXEL_SIZE_Y / 2 - 1, -VOXEL_SIZE_Z / 2};
+size_t voxel_block_count;
+size_t voxel_face_count; // Quads world_builder_voxels adds, it sizes the voxel mesh
+World_Mode world_mode = WORLD_HEIGHTMAP;
+double mesh_ms;
+
+// B meshes the voxels every way and shows the results in the HUD
+#define VOXEL_BENCHMARK_METHODS 3
+static const char *voxel_benchmark_names[VOXEL_BENCHMARK_METHODS] = {"add_cube", "voxels", "greedy"};
+size_t voxel_benchmark_vertices[VOXEL_BENCHMARK_METHODS];
+double voxel_benchmark_ms[VOXEL_BENCHMARK_METHODS];
+bool voxel_benchmark_requested;
+bool voxel_benchmark_done;
+
+// Chunks are meshed on every core, each thread into its own arena
+#define THREAD_ARENA_BLOCK_SIZE (1024 * 1024)
+Cab_Worker_Pool *worker_pool;
+ChunkWorld chunk_world;
+int chunks_remeshed;
+int chunks_initial;       // Chunks meshed by the first update in init, and how long it took
+double chunks_initial_ms;
+uint32_t edit_seed = 1;
+
+Terrain terrain;
+double terrain_init_ms;
+size_t waves_element_count;
 
 
 float height_func(float x, float z) {
-    return 2.0f * sinf(x * 0.2f) + 0.6f * cosf(x * 0.8f) +
-           2.0f * cosf(z * 0.2f) + 0.6f * sinf(z * 0.8f);
+    return 2.0f * fast_sinf(x * 0.2f) + 0.6f * fast_cosf(x * 0.8f) +
+           2.0f * fast_cosf(z * 0.2f) + 0.6f * fast_sinf(z * 0.8f);
+}
+
+// height_func for a whole row: the z terms are shared and the x terms go through the batch trig
+void height_row(float x, float z, float step, int count, float *heights) {
+    float slow[HEIGHTMAP_ROW_TILES + 1];
+    float fast[HEIGHTMAP_ROW_TILES + 1];
+    for (int i = 0; i < count; i++) {
+        slow[i] = (x + i * step) * 0.2f;
+        fast[i] = (x + i * step) * 0.8f;
+    }
+    fast_sinf_batch(slow, slow, count);
+    fast_cosf_batch(fast, fast, count);
+    float row = 2.0f * fast_cosf(z * 0.2f) + 0.6f * fast_sinf(z * 0.8f);
+    for (int i = 0; i < count; i++) {
+        heights[i] = 2.0f * slow[i] + 0.6f * fast[i] + row;
+    }
+}
+
+void create_voxels() {
+    voxel_block_count = 0;
+    for (int z = 0; z < VOXEL_SIZE_Z; z++) {
+        for (int x = 0; x < VOXEL_SIZE_X; x++) {
+            float h = height_func(x - VOXEL_SIZE_X / 2 + 0.5f, z - VOXEL_SIZE_Z / 2 + 0.5f);
+            int top = (int)(h + VOXEL_SIZE_Y / 2);
+            for (int y = 0; y < VOXEL_SIZE_Y; y++) {
+                uint8_t block = y < top ? 6 : y == top ? (h < 0.0f ? 6 : 12) : VOXEL_AIR;
+                voxels[VOXEL_INDEX(VOXEL_SIZE_X, VOXEL_SIZE_Z, x, y, z)] = block;
+                voxel_block_count += block != VOXEL_AIR;
+            }
+        }
+    }
+    voxel_face_count = world_builder_voxel_face_count(voxels, VOXEL_SIZE_X, VOXEL_SIZE_Y, VOXEL_SIZE_Z);
+    assert(voxel_face_count <= MAX_QUADS);
+}
+
+void create_chunk_world() {
+    vec3 origin = {-WORLD_CHUNKS_X * CHUNK_SIZE / 2, -WORLD_CHUNKS_Y * CHUNK_SIZE / 2 - 4, -WORLD_CHUNKS_Z * CHUNK_SIZE / 2};
+    chunk_world_init(&chunk_world, world_arena, WORLD_CHUNKS_X, WORLD_CHUNKS_Y, WORLD_CHUNKS_Z, origin);
+    for (int z = 0; z < chunk_world.size_z; z++) {
+        for (int x = 0; x < chunk_world.size_x; x++) {
+            float h = height_func(origin.x + x + 0.5f, origin.z + z + 0.5f);
+            int top = (int)(h - origin.y);
+            for (int y = 0; y <= top && y < chunk_world.size_y; y++) {
+                chunk_world_set_block(&chunk_world, x, y, z, y < top ? 6 : (h < 0.0f ? 6 : 12));
+            }
+        }
+    }
+}
+
+// Dig out or put back the top block of a random column, so a frame only touches one or two chunks
+void edit_chunk_world() {
+    edit_seed ^= edit_seed << 13;
+    edit_seed ^= edit_seed >> 17;
+    edit_seed ^= edit_seed << 5;
+    int x = (int)(edit_seed % (uint32_t)chunk_world.size_x);
+    int z = (int)((edit_seed >> 16) % (uint32_t)chunk_world.size_z);
+    int y = chunk_world.size_y - 1;
+    while (y > 0 && chunk_world_get_block(&chunk_world, x, y, z) == VOXEL_AIR) {
+        y--;
+    }
+    if (edit_seed & 0x100) {
+        chunk_world_set_block(&chunk_world, x, y, z, VOXEL_AIR);
+    } else {
+        chunk_world_set_block(&chunk_world, x, y + 1, z, 12);
+    }
+}
+
+// Mesh the voxel terrain with a cube per block, with hidden faces culled and greedy merged,
+// and keep how many vertices and how much time each one takes. Leaves builder with the last mesh
+void benchmark_voxels() {
+    enum { RUNS = 20 };
+    for (int method = 0; method < VOXEL_BENCHMARK_METHODS; method++) {
+        uint64_t start = stm_now();
+        for (int run = 0; run < RUNS; run++) {
+            world_builder_init_packed(&builder, vertices, MAX_QUADS * QUAD_VERTICES, (vec3){0.0f, 0.0f, 0.0f});
+            if (method == 0) {
+                for (int y = 0; y < VOXEL_SIZE_Y; y++) {
+                    for (int z = 0; z < VOXEL_SIZE_Z; z++) {
+                        for (int x = 0; x < VOXEL_SIZE_X; x++) {
+                            uint8_t block = voxels[VOXEL_INDEX(VOXEL_SIZE_X, VOXEL_SIZE_Z, x, y, z)];
+                            if (block == VOXEL_AIR) {
+                                continue;
+                            }
+                            uint16_t t = block - 1;
+                            vec3 center = vec3_add(voxel_origin, (vec3){x + 0.5f, y + 0.5f, z + 0.5f});
+                            world_builder_add_cube(&builder, center, 1.0f, t, t, t, t, t, t);
+                        }
+                    }
+                }
+            } else if (method == 1) {
+                world_builder_voxels(&builder, voxels, VOXEL_SIZE_X, VOXEL_SIZE_Y, VOXEL_SIZE_Z, voxel_origin, 1.0f);
+            } else {
+                world_builder_voxels_greedy(&builder, voxels, VOXEL_SIZE_X, VOXEL_SIZE_Y, VOXEL_SIZE_Z, voxel_origin, 1.0f);
+            }
+        }
+        voxel_benchmark_ms[method] = stm_ms(stm_since(start)) / RUNS;
+        voxel_benchmark_vertices[method] = world_builder_get_vertex_count(&builder);
+    }
+    voxel_benchmark_done = true;
+}
+
+// The waves mesh never changes, so it is built once into an immutable buffer and all of the
+// animation happens in vs_waves. Uses the shared vertex memory before create_world fills it
+void create_waves() {
+    world_builder_init_packed(&builder, vertices, MAX_QUADS * QUAD_VERTICES, (vec3){0.0f, 0.0f, 0.0f});
+    world_builder_heightmap_rows(&builder, 40.0f, 40.0f, WAVES_TILE_SIZE, height_row);
+    waves_element_count = world_builder_get_element_count(&builder);
+    state.waves_buffer = sg_make_buffer(&(sg_buffer_desc){
+        .data = {vertices, builder.size},
+        .type = SG_BUFFERTYPE_VERTEXBUFFER,
+        .label = "waves-vertices",
+    });
 }
 
 void create_world(float t) {
-    world_builder_init(&builder, vertices, sizeof(vertices) / sizeof(float));
-    world_builder_heightmap(&builder, 40.0f, 40.0f, 1.0f, height_func);
+    world_builder_init_packed(&builder, vertices, MAX_QUADS * QUAD_VERTICES, (vec3){0.0f, 0.0f, 0.0f});
+    switch (world_mode) {
+    case WORLD_VOXELS:
+        world_builder_init_packed(&builder, vertices, voxel_face_count * QUAD_VERTICES, (vec3){0.0f, 0.0f, 0.0f});
+        world_builder_voxels(&builder, voxels, VOXEL_SIZE_X, VOXEL_SIZE_Y, VOXEL_SIZE_Z, voxel_origin, 1.0f);
+        break;
+    case WORLD_VOXELS_GREEDY:
+        world_builder_voxels_greedy(&builder, voxels, VOXEL_SIZE_X, VOXEL_SIZE_Y, VOXEL_SIZE_Z, voxel_origin, 1.0f);
+        break;
+    default:
+        world_builder_heightmap_rows(&builder, 40.0f, 40.0f, 1.0f, height_row);
+        break;
+    }
 
     // for (float z = -20; z < 20; z++) {
     //     for (float x = -20; x < 20; x++) {
@@ -82,9 +273,23 @@ void create_world(float t) {
 }
 
 
+// The demo cannot run without its startup allocations
+static void *check_alloc(void *ptr, const char *what) {
+    if (!ptr) {
+        fprintf(stderr, "Out of memory allocating %s\n", what);
+        abort();
+    }
+    return ptr;
+}
+
 void init() {
     stm_setup();
 
+    world_arena = check_alloc(cab_arena_create_virtual_tagged(WORLD_ARENA_RESERVE, CAB_MEM_TAG_MESH), "the world arena");
+    vertices = check_alloc(cab_arena_alloc(world_arena, MAX_QUADS * QUAD_VERTICES * sizeof(Packed_Vertex)), "vertices");
+    cab_thread_arenas_init(THREAD_ARENA_BLOCK_SIZE);
+    worker_pool = cab_worker_pool_create(0);
+
     sg_setup(&(sg_desc) {
         .environment = sglue_environment(),
         .logger.func = slog_func,
@@ -106,12 +311,24 @@ void init() {
 
    state.bind.vertex_buffers[0] = sg_make_buffer(&(sg_buffer_desc){
         // .data = SG_RANGE(vertices),
-        .size = sizeof(vertices),
+        .size = MAX_QUADS * QUAD_VERTICES * sizeof(Packed_Vertex),
         .type = SG_BUFFERTYPE_VERTEXBUFFER,
         .usage = SG_USAGE_DYNAMIC,
         .label = "cube-vertices"
     });
 
+    // Every quad uses the same 6 index pattern, so the index buffer is built once and never updated
+    Cab_Arena_Mark mark = cab_arena_mark(world_arena);
+    size_t index_size = MAX_QUADS * QUAD_INDICES * sizeof(uint32_t);
+    uint32_t *indices = check_alloc(cab_arena_alloc(world_arena, index_size), "indices");
+    world_builder_quad_indices32(indices, MAX_QUADS);
+    state.bind.index_buffer = sg_make_buffer(&(sg_buffer_desc){
+        .data = {indices, index_size},
+        .type = SG_BUFFERTYPE_INDEXBUFFER,
+        .label = "cube-indices"
+    });
+    cab_arena_rewind(world_arena, mark);
+
     state.bind.images[IMG_tex] = sg_alloc_image();
     state.bind.samplers[SMP_smp] = sg_make_sampler(&(sg_sampler_desc) {
         .min_filter = SG_FILTER_NEAREST,
@@ -121,14 +338,13 @@ void init() {
         .label = "cube-sampler",
     });
 
-    sg_shader shd = sg_make_shader(textured_shader_desc(sg_query_backend()));
+    sg_shader shd = sg_make_shader(textured_packed_shader_desc(sg_query_backend()));
 
     state.pip = sg_make_pipeline(&(sg_pipeline_desc) {
         .shader = shd,
         .layout = {
             .attrs = {
-                [ATTR_textured_a_pos].format = SG_VERTEXFORMAT_FLOAT3,
-                [ATTR_textured_a_texcoord].format = SG_VERTEXFORMAT_FLOAT2,
+                [ATTR_textured_packed_a_packed].format = SG_VERTEXFORMAT_SHORT4,
             },
         },
         .cull_mode = SG_CULLMODE_BACK,
@@ -137,9 +353,28 @@ void init() {
             .compare = SG_COMPAREFUNC_LESS_EQUAL,
         },
         .primitive_type = SG_PRIMITIVETYPE_TRIANGLES,
+        .index_type = SG_INDEXTYPE_UINT32,
         .label = "cube-pipeline",
     });
 
+    // Same vertex layout and state, the waves shader only adds the time displacement
+    state.waves_pip = sg_make_pipeline(&(sg_pipeline_desc) {
+        .shader = sg_make_shader(textured_waves_shader_desc(sg_query_backend())),
+        .layout = {
+            .attrs = {
+                [ATTR_textured_waves_a_packed].format = SG_VERTEXFORMAT_SHORT4,
+            },
+        },
+        .cull_mode = SG_CULLMODE_BACK,
+        .depth = {
+            .write_enabled = true,
+            .compare = SG_COMPAREFUNC_LESS_EQUAL,
+        },
+        .primitive_type = SG_PRIMITIVETYPE_TRIANGLES,
+        .index_type = SG_INDEXTYPE_UINT32,
+        .label = "waves-pipeline",
+    });
+
     state.pass_action = (sg_pass_action) {
         .colors[0] = {
             .load_action = SG_LOADACTION_CLEAR,
@@ -154,7 +389,18 @@ void init() {
         .buffer = SFETCH_RANGE(state.file_buffer),
     });
 
+    create_voxels();
+    create_chunk_world();
+    uint64_t chunk_start = stm_now();
+    chunks_initial = chunk_world_update(&chunk_world, worker_pool);
+    chunks_initial_ms = stm_ms(stm_since(chunk_start));
+    create_waves();
     create_world(0.0f);
+
+    uint64_t terrain_start = stm_now();
+    terrain_init(&terrain, world_arena, TERRAIN_SIZE, TERRAIN_LEVELS, TERRAIN_LOD_DISTANCE, NULL, height_row);
+    terrain_init_ms = stm_ms(stm_since(terrain_start));
+    assert(terrain.quad_count <= MAX_QUADS); // Terrain nodes draw with the shared quad index buffer
 }
 
 static void fetch_callback(const sfetch_response_t *fetch) {
@@ -194,20 +440,34 @@ bool is_updated = false;
 
 void update() {
     sfetch_dowork();
+    if (voxel_benchmark_requested) {
+        voxel_benchmark_requested = false;
+        benchmark_voxels();
+        create_world(0.0f); // The benchmark meshes into the shared builder
+    }
 
     uint32_t frame_count = sapp_frame_count();
     double frame_time = sapp_frame_duration() * 1000.0; 
 
-    vs_params_t vs_params;
+    vs_packed_params_t vs_params;
     const float w = sapp_widthf();
     const float h = sapp_heightf();
     const float t = (float)sapp_frame_duration();
     state.rx += 0.0f; 
     state.ry += 0.2f * t;
-    mat4 proj = mat4_perspective(60.0f * 3.1456f / 180.0f, w / h, 0.1f, 100.0f);
-    mat4 view = mat4_look_at((vec3){0.0f, 5.0f, -30.0f}, (vec3){0.0f, -10.0f, 0.0f}, (vec3){0.0f, 1.0f, 0.0f});
-    mat4 model = mat4_rotate_y(mat4_rotate_x(mat4_create(), state.rx), state.ry);
+    float far_plane = world_mode == WORLD_TERRAIN ? TERRAIN_SIZE : 100.0f;
+    mat4 proj = mat4_perspective(60.0f * 3.1456f / 180.0f, w / h, 0.1f, far_plane);
+    vec3 eye = {0.0f, 5.0f, -30.0f};
+    mat4 view = mat4_look_at(eye, (vec3){0.0f, -10.0f, 0.0f}, (vec3){0.0f, 1.0f, 0.0f});
+    transform model_transform = transform_identity();
+    model_transform.rotation = quat_multiply(quat_from_axis_angle((vec3){1.0f, 0.0f, 0.0f}, state.rx),
+                                             quat_from_axis_angle((vec3){0.0f, 1.0f, 0.0f}, state.ry));
+    mat4 model = mat4_from_transform(model_transform);
     vs_params.mvp = mat4_multiply(mat4_multiply(proj, view), model);
+    vs_params.origin_scale[0] = builder.origin.x;
+    vs_params.origin_scale[1] = builder.origin.y;
+    vs_params.origin_scale[2] = builder.origin.z;
+    vs_params.origin_scale[3] = 1.0f / PACKED_POSITION_SCALE;
 
     sdtx_canvas(sapp_width() / 4.0f, sapp_height() / 4.0f);
     sdtx_origin(5.0f, 5.0f);
@@ -215,14 +475,61 @@ void update() {
     sdtx_color1i(0xFFFFFFFF);
 
     size_t vertex_count = world_builder_get_vertex_count(&builder);
+    size_t index_count = world_builder_get_element_count(&builder);
+    if (world_mode == WORLD_CHUNKS) {
+        index_count = chunk_world_element_count(&chunk_world);
+        vertex_count = index_count / QUAD_INDICES * QUAD_VERTICES;
+    } else if (world_mode == WORLD_TERRAIN) {
+        index_count = terrain_element_count(&terrain);
+        vertex_count = index_count / QUAD_INDICES * QUAD_VERTICES;
+    } else if (world_mode == WORLD_WAVES) {
+        index_count = waves_element_count;
+        vertex_count = index_count / QUAD_INDICES * QUAD_VERTICES;
+    }
     sdtx_printf("Vertices: %zu\n", vertex_count); 
-    sdtx_printf("Triangles: %zu\n", vertex_count / 3);
-    sdtx_printf("Cubes: %zu\n", vertex_count / 36);
+    sdtx_printf("Triangles: %zu\n", index_count / 3);
+    sdtx_printf("Cubes: %zu\n", index_count / 36);
+    sdtx_printf("Mesh: %s %.2f ms\n", world_mode_names[world_mode], mesh_ms);
+    if (world_mode == WORLD_CHUNKS) {
+        sdtx_printf("Remeshed: %d of %d chunks\n", chunks_remeshed, chunk_world.chunk_count);
+        sdtx_printf("Initial: %d chunks %.2f ms\n", chunks_initial, chunks_initial_ms);
+        sdtx_printf("Threads: %u\n", cab_worker_pool_thread_count(worker_pool));
+    } else if (world_mode == WORLD_TERRAIN) {
+        sdtx_printf("Nodes: %d drawn, %d culled\n", terrain.selected_count, terrain.culled_count);
+        sdtx_printf("Built: %d nodes %zu quads %.2f ms\n", terrain.node_count, terrain.quad_count, terrain_init_ms);
+    } else if (world_mode != WORLD_HEIGHTMAP && world_mode != WORLD_WAVES) {
+        // Every cube would add 6 faces without hidden face culling
+        sdtx_printf("Quads: %zu of %zu\n", index_count / QUAD_INDICES, voxel_block_count * 6);
+    }
+    if (voxel_benchmark_done) {
+        for (int method = 0; method < VOXEL_BENCHMARK_METHODS; method++) {
+            sdtx_printf("%-8s %7zu verts %6.2f ms\n", voxel_benchmark_names[method],
+                        voxel_benchmark_vertices[method], voxel_benchmark_ms[method]);
+        }
+    }
 
     float now = stm_ms(stm_now());
-    if (!is_updated) {
+    if (world_mode == WORLD_CHUNKS) {
+        // Only chunks touched by the edit are remeshed and uploaded
+        edit_chunk_world();
+        uint64_t mesh_start = stm_now();
+        chunks_remeshed = chunk_world_update(&chunk_world, worker_pool);
+        mesh_ms = stm_ms(stm_since(mesh_start));
+    } else if (world_mode == WORLD_TERRAIN) {
+        // The terrain is meshed once, only the node selection runs per frame. The model
+        // rotates, so the camera and frustum are taken into terrain space
+        uint64_t mesh_start = stm_now();
+        mat4 inverse_model = mat4_inverse(model);
+        frustum view_frustum = frustum_from_mat4(vs_params.mvp);
+        terrain_select(&terrain, mat4_transform_point(&inverse_model, eye), &view_frustum);
+        mesh_ms = stm_ms(stm_since(mesh_start));
+    } else if (world_mode == WORLD_WAVES) {
+        mesh_ms = 0.0; // Nothing to mesh or upload, only the time uniform changes
+    } else if (!is_updated) {
+        uint64_t mesh_start = stm_now();
         create_world(now);
-        sg_update_buffer(state.bind.vertex_buffers[0], &(sg_range){ .ptr = vertices, .size = builder.current_index * sizeof(float) });
+        mesh_ms = stm_ms(stm_since(mesh_start));
+        sg_update_buffer(state.bind.vertex_buffers[0], &(sg_range){ .ptr = vertices, .size = builder.size });
         //is_updated = true;
     }
 
@@ -230,10 +537,51 @@ void update() {
     //state.pass_action.colors[0].clear_value.g = g > 1.0f ? 0.0f : g;
     sg_begin_pass(&(sg_pass){ .action = state.pass_action, .swapchain = sglue_swapchain() });
 
-    sg_apply_pipeline(state.pip);
-    sg_apply_bindings(&state.bind);
-    sg_apply_uniforms(UB_vs_params, SG_RANGE_REF(vs_params));
-    sg_draw(0, world_builder_get_vertex_count(&builder), 1);
+    sg_apply_pipeline(world_mode == WORLD_WAVES ? state.waves_pip : state.pip);
+    if (world_mode == WORLD_CHUNKS) {
+        sg_bindings bind = state.bind;
+        for (int i = 0; i < chunk_world.chunk_count; i++) {
+            Chunk *chunk = &chunk_world.chunks[i];
+            if (chunk->element_count == 0) {
+                continue;
+            }
+            bind.vertex_buffers[0] = chunk->vertex_buffer;
+            vs_params.origin_scale[0] = chunk->origin.x;
+            vs_params.origin_scale[1] = chunk->origin.y;
+            vs_params.origin_scale[2] = chunk->origin.z;
+            sg_apply_bindings(&bind);
+            sg_apply_uniforms(UB_vs_packed_params, SG_RANGE_REF(vs_params));
+            sg_draw(0, chunk->element_count, 1);
+        }
+    } else if (world_mode == WORLD_TERRAIN) {
+        sg_bindings bind = state.bind;
+        bind.vertex_buffers[0] = terrain.vertex_buffer;
+        sg_apply_bindings(&bind);
+        for (int i = 0; i < terrain.selected_count; i++) {
+            const Terrain_Node *node = &terrain.nodes[terrain.selected[i]];
+            vs_params.origin_scale[0] = node->origin.x;
+            vs_params.origin_scale[1] = node->origin.y;
+            vs_params.origin_scale[2] = node->origin.z;
+            vs_params.origin_scale[3] = 1.0f / node->position_scale;
+            sg_apply_uniforms(UB_vs_packed_params, SG_RANGE_REF(vs_params));
+            sg_draw(node->first_element, node->element_count, 1);
+        }
+    } else if (world_mode == WORLD_WAVES) {
+        vs_waves_params_t waves_params = {
+            .mvp = vs_params.mvp,
+            .origin_scale = {0.0f, 0.0f, 0.0f, 1.0f / PACKED_POSITION_SCALE},
+            .wave = {(float)stm_sec(stm_now()), WAVES_AMPLITUDE, WAVES_FREQUENCY, WAVES_SPEED},
+        };
+        sg_bindings bind = state.bind;
+        bind.vertex_buffers[0] = state.waves_buffer;
+        sg_apply_bindings(&bind);
+        sg_apply_uniforms(UB_vs_waves_params, SG_RANGE_REF(waves_params));
+        sg_draw(0, waves_element_count, 1);
+    } else {
+        sg_apply_bindings(&state.bind);
+        sg_apply_uniforms(UB_vs_packed_params, SG_RANGE_REF(vs_params));
+        sg_draw(0, world_builder_get_element_count(&builder), 1);
+    }
 
     sdtx_draw();
 
@@ -242,11 +590,21 @@ void update() {
 }
 
 void cleanup() {
+    chunk_world_shutdown(&chunk_world);
+    terrain_shutdown(&terrain);
     sg_shutdown();
+    cab_worker_pool_destroy(worker_pool);
+    cab_thread_arenas_shutdown();
+    cab_arena_destroy(world_arena);
 }
 
 void handle_event(const sapp_event* event) {
-    // todo: handle events
+    if (event->type == SAPP_EVENTTYPE_KEY_DOWN && event->key_code == SAPP_KEYCODE_V && !event->key_repeat) {
+        world_mode = (world_mode + 1) % WORLD_MODE_COUNT;
+    }
+    if (event->type == SAPP_EVENTTYPE_KEY_DOWN && event->key_code == SAPP_KEYCODE_B && !event->key_repeat) {
+        voxel_benchmark_requested = true;
+    }
 }
 
 sapp_desc sokol_main(int argc, char* argv[]) {
@@ -0,0 +1,159 @@
+#include "sokol_gfx.h"
+#include "terrain.h"
+
+#define TERRAIN_NODE_VERTICES (TERRAIN_NODE_QUADS * QUAD_VERTICES)
+
+// Lay the quadtree out breadth first, giving each node its square and packing scale
+static void build_nodes(Terrain* terrain) {
+    float root_tile = terrain->size / TERRAIN_NODE_TILES;
+    float leaf_tile = root_tile / (float)(1 << (terrain->levels - 1)); // Halving is exact
+    terrain->nodes[0] = (Terrain_Node){.tile_size = root_tile};
+    int count = 1;
+    for (int i = 0; i < count; i++) {
+        Terrain_Node* node = &terrain->nodes[i];
+        node->position_scale = fminf(PACKED_POSITION_SCALE, PACKED_POSITION_SCALE / node->tile_size);
+        if (node->tile_size <= leaf_tile) {
+            continue;
+        }
+        float quarter = node->tile_size * TERRAIN_NODE_TILES * 0.25f;
+        node->children = (uint32_t)count;
+        for (int child = 0; child < 4; child++) {
+            vec3 offset = {(child & 1) ? quarter : -quarter, 0.0f, (child & 2) ? quarter : -quarter};
+            terrain->nodes[count++] = (Terrain_Node){
+                .origin = vec3_add(node->origin, offset),
+                .tile_size = node->tile_size * 0.5f,
+            };
+        }
+    }
+}
+
+// Height range of a packed mesh, skirts included
+static void mesh_height_range(const Terrain_Node* node, const Packed_Vertex* vertices, size_t count, float* min_y, float* max_y) {
+    int lo = INT16_MAX;
+    int hi = INT16_MIN;
+    for (size_t i = 0; i < count; i++) {
+        lo = vertices[i].y < lo ? vertices[i].y : lo;
+        hi = vertices[i].y > hi ? vertices[i].y : hi;
+    }
+    *min_y = count > 0 ? node->origin.y + lo / node->position_scale : 0.0f;
+    *max_y = count > 0 ? node->origin.y + hi / node->position_scale : 0.0f;
+}
+
+void terrain_init(
+    Terrain* terrain,
+    Cab_Arena* arena,
+    float size,
+    int levels,
+    float lod_distance,
+    Heightmap_Func heightmap_func,
+    Heightmap_Row_Func row_func
+) {
+    levels = levels < 1 ? 1 : levels > TERRAIN_MAX_LEVELS ? TERRAIN_MAX_LEVELS : levels;
+    *terrain = (Terrain){
+        .node_count = ((1 << (2 * levels)) - 1) / 3,
+        .levels = levels,
+        .size = size,
+        .lod_distance = lod_distance,
+    };
+    terrain->nodes = cab_arena_alloc(arena, terrain->node_count * sizeof(Terrain_Node));
+    terrain->selected = cab_arena_alloc(arena, terrain->node_count * sizeof(uint32_t));
+    build_nodes(terrain);
+
+    // Every node is meshed into one staging buffer, uploaded as one immutable vertex buffer
+    Cab_Arena_Mark mark = cab_arena_mark(arena);
+    size_t staging_size = terrain->node_count * TERRAIN_NODE_VERTICES * sizeof(Packed_Vertex);
+    Packed_Vertex* staging = cab_arena_alloc(arena, staging_size);
+    size_t vertex_count = 0;
+    for (int i = 0; i < terrain->node_count; i++) {
+        Terrain_Node* node = &terrain->nodes[i];
+        float half = node->tile_size * TERRAIN_NODE_TILES * 0.5f;
+        WorldBuilder builder;
+        world_builder_init_packed_scaled(&builder, staging + vertex_count, TERRAIN_NODE_VERTICES, node->origin, node->position_scale);
+        world_builder_heightmap_patch(&builder, node->origin.x - half, node->origin.z - half, TERRAIN_NODE_TILES, TERRAIN_NODE_TILES,
+                                      node->tile_size, node->tile_size * TERRAIN_SKIRT_TILES, heightmap_func, row_func);
+
+        size_t node_vertices = world_builder_get_vertex_count(&builder);
+        float min_y, max_y;
+        mesh_height_range(node, staging + vertex_count, node_vertices, &min_y, &max_y);
+        node->center = (vec3){node->origin.x, (min_y + max_y) * 0.5f, node->origin.z};
+        node->extents = (vec3){half, (max_y - min_y) * 0.5f, half};
+        node->first_element = (uint32_t)(vertex_count / QUAD_VERTICES * QUAD_INDICES);
+        node->element_count = (uint32_t)world_builder_get_element_count(&builder);
+        vertex_count += node_vertices;
+    }
+    terrain->quad_count = vertex_count / QUAD_VERTICES;
+    if (vertex_count > 0) {
+        terrain->vertex_buffer = sg_make_buffer(&(sg_buffer_desc){
+            .data = {staging, vertex_count * sizeof(Packed_Vertex)},
+            .type = SG_BUFFERTYPE_VERTEXBUFFER,
+            .label = "terrain-vertices",
+        });
+    }
+    cab_arena_rewind(arena, mark);
+
+    // Grow parent bounds over their children, children always come after their parent
+    for (int i = terrain->node_count - 1; i >= 0; i--) {
+        Terrain_Node* node = &terrain->nodes[i];
+        if (!node->children) {
+            continue;
+        }
+        float min_y = node->center.y - node->extents.y;
+        float max_y = node->center.y + node->extents.y;
+        for (uint32_t child = node->children; child < node->children + 4; child++) {
+            const Terrain_Node* c = &terrain->nodes[child];
+            min_y = fminf(min_y, c->center.y - c->extents.y);
+            max_y = fmaxf(max_y, c->center.y + c->extents.y);
+        }
+        node->center.y = (min_y + max_y) * 0.5f;
+        node->extents.y = (max_y - min_y) * 0.5f;
+    }
+}
+
+void terrain_shutdown(Terrain* terrain) {
+    if (terrain->quad_count > 0) {
+        sg_destroy_buffer(terrain->vertex_buffer);
+    }
+    *terrain = (Terrain){0};
+}
+
+static float distance_to_box(vec3 point, vec3 center, vec3 extents) {
+    vec3 d = {
+        fmaxf(fabsf(point.x - center.x) - extents.x, 0.0f),
+        fmaxf(fabsf(point.y - center.y) - extents.y, 0.0f),
+        fmaxf(fabsf(point.z - center.z) - extents.z, 0.0f),
+    };
+    return vec3_length(d);
+}
+
+static void select_node(Terrain* terrain, uint32_t index, vec3 eye, const frustum* view) {
+    const Terrain_Node* node = &terrain->nodes[index];
+    if (view && !frustum_test_aabb(view, node->center, node->extents)) {
+        terrain->culled_count++;
+        return;
+    }
+    float node_size = node->tile_size * TERRAIN_NODE_TILES;
+    if (node->children && distance_to_box(eye, node->center, node->extents) < terrain->lod_distance * node_size) {
+        for (uint32_t child = node->children; child < node->children + 4; child++) {
+            select_node(terrain, child, eye, view);
+        }
+        return;
+    }
+    terrain->selected[terrain->selected_count++] = index;
+}
+
+int terrain_select(Terrain* terrain, vec3 eye, const frustum* view) {
+    terrain->selected_count = 0;
+    terrain->culled_count = 0;
+    if (terrain->node_count > 0) {
+        select_node(terrain, 0, eye, view);
+    }
+    return terrain->selected_count;
+}
+
+size_t terrain_element_count(const Terrain* terrain) {
+    size_t count = 0;
+    for (int i = 0; i < terrain->selected_count; i++) {
+        count += terrain->nodes[terrain->selected[i]].element_count;
+    }
+    return count;
+}
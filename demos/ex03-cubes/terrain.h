@@ -0,0 +1,73 @@
+#ifndef TERRAIN_H
+#define TERRAIN_H
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "cmath.h"
+#include "world_builder.h"
+
+#if !defined(SOKOL_GFX_INCLUDED)
+#error "Please include sokol_gfx.h before terrain.h"
+#endif
+
+#define TERRAIN_NODE_TILES 16 // Tiles per node side on every level
+#define TERRAIN_MAX_LEVELS 8
+#define TERRAIN_NODE_QUADS HEIGHTMAP_PATCH_QUADS(TERRAIN_NODE_TILES, TERRAIN_NODE_TILES, true)
+#define TERRAIN_SKIRT_TILES 2.0f // Skirt depth in tiles of the node
+
+// A square of terrain meshed with TERRAIN_NODE_TILES tiles per side, so a node has the same
+// quad count on every level and children halve the tile size. Vertices are Packed_Vertex
+// relative to origin with a scale that grows with the tile size, so big nodes stay in range
+typedef struct {
+    vec3 center;            // Bounding box of the node and all of its children
+    vec3 extents;
+    vec3 origin;            // Node center at height zero, vertices are packed against it
+    float position_scale;   // Packed steps per unit
+    float tile_size;
+    uint32_t first_element; // Offset into the shared quad index pattern
+    uint32_t element_count;
+    uint32_t children;      // Index of the first of 4 children, 0 for leaves
+} Terrain_Node;
+
+// Quadtree of heightmap nodes over a square centered on the origin, all meshed once into one
+// vertex buffer. terrain_select picks the coarsest nodes that are fine enough for their
+// distance to the camera, so the drawn quad count stays about the same however large the
+// terrain is. Skirts hide the cracks where neighbouring nodes have different tile sizes
+typedef struct {
+    Terrain_Node* nodes;    // Breadth first, the 4 children of a node are contiguous
+    int node_count;
+    int levels;
+    float size;
+    float lod_distance;     // A node splits while the camera is closer than lod_distance * its size
+    sg_buffer vertex_buffer;
+    size_t quad_count;      // Quads in vertex_buffer, the index buffer needs as many
+    uint32_t* selected;     // Nodes to draw, filled by terrain_select
+    int selected_count;
+    int culled_count;       // Subtrees outside the frustum in the last terrain_select
+} Terrain;
+
+// Meshes every node of a levels deep quadtree over a size * size square. Leaves get tiles of
+// size / 2^(levels - 1) / TERRAIN_NODE_TILES. Heights come from row_func, or heightmap_func
+// when row_func is NULL. Node data comes from arena, the meshes are staged in it and rewound
+void terrain_init(
+    Terrain* terrain,
+    Cab_Arena* arena,
+    float size,
+    int levels,
+    float lod_distance,
+    Heightmap_Func heightmap_func,
+    Heightmap_Row_Func row_func
+);
+// Destroys the vertex buffer, the memory goes away with the arena
+void terrain_shutdown(Terrain* terrain);
+
+// Select the nodes to draw for a camera at eye. Subtrees whose bounds are outside view are
+// skipped, view may be NULL to draw everything. eye and view are in terrain space.
+// Returns the number of nodes selected
+int terrain_select(Terrain* terrain, vec3 eye, const frustum* view);
+
+// Indices to draw for the selected nodes, for the HUD
+size_t terrain_element_count(const Terrain* terrain);
+
+#endif // TERRAIN_H
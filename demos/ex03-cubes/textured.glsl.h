@@ -1,11 +1,13 @@
 #pragma once
 /*
-    #version:1# (machine generated, don't edit!)
+    #version:1# (written by hand in sokol-shdc output format, don't edit!)
 
-    Generated by sokol-shdc (https://github.com/floooh/sokol-tools)
+    Not checked by a shader compiler yet. ./nob replaces this header with real
+    sokol-shdc (https://github.com/floooh/sokol-tools) output on the first build
+    where sokol-shdc is on the PATH or in $SOKOL_SHDC.
 
     Cmdline:
-        sokol-shdc --input demos/ex03-cubes/textured.glsl --output demos/ex03-cubes/textured.glsl.h -l hlsl5:glsl430
+        sokol-shdc --input demos/ex03-cubes/textured.glsl --output demos/ex03-cubes/textured.glsl.h --slang glsl430:glsl300es:hlsl5
 
     Overview:
     =========
@@ -16,10 +18,28 @@
         Attributes:
             ATTR_textured_a_pos => 0
             ATTR_textured_a_texcoord => 1
+    Shader program: 'textured_packed':
+        Get shader desc: textured_packed_shader_desc(sg_query_backend());
+        Vertex Shader: vs_packed
+        Fragment Shader: fs_tiled
+        Attributes:
+            ATTR_textured_packed_a_packed => 0
+    Shader program: 'textured_waves':
+        Get shader desc: textured_waves_shader_desc(sg_query_backend());
+        Vertex Shader: vs_waves
+        Fragment Shader: fs_tiled
+        Attributes:
+            ATTR_textured_waves_a_packed => 0
     Bindings:
         Uniform block 'vs_params':
             C struct: vs_params_t
             Bind slot: UB_vs_params => 0
+        Uniform block 'vs_packed_params':
+            C struct: vs_packed_params_t
+            Bind slot: UB_vs_packed_params => 0
+        Uniform block 'vs_waves_params':
+            C struct: vs_waves_params_t
+            Bind slot: UB_vs_waves_params => 0
         Image 'tex':
             Image type: SG_IMAGETYPE_2D
             Sample type: SG_IMAGESAMPLETYPE_FLOAT
@@ -41,13 +61,26 @@
 #endif
 #define ATTR_textured_a_pos (0)
 #define ATTR_textured_a_texcoord (1)
+#define ATTR_textured_packed_a_packed (0)
+#define ATTR_textured_waves_a_packed (0)
 #define UB_vs_params (0)
+#define UB_vs_packed_params (0)
+#define UB_vs_waves_params (0)
 #define IMG_tex (0)
 #define SMP_smp (0)
 #pragma pack(push,1)
 SOKOL_SHDC_ALIGN(16) typedef struct vs_params_t {
     mat4 mvp;
 } vs_params_t;
+SOKOL_SHDC_ALIGN(16) typedef struct vs_packed_params_t {
+    mat4 mvp;
+    float origin_scale[4];
+} vs_packed_params_t;
+SOKOL_SHDC_ALIGN(16) typedef struct vs_waves_params_t {
+    mat4 mvp;
+    float origin_scale[4];
+    float wave[4];
+} vs_waves_params_t;
 #pragma pack(pop)
 /*
     #version 430
@@ -115,6 +148,263 @@ static const uint8_t fs_source_glsl430[212] = {
     0x70,0x2c,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x29,0x3b,0x0a,
     0x7d,0x0a,0x0a,0x00,
 };
+/*
+    #version 430
+
+    const vec3 _70[6] = vec3[](vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0), vec3(1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0));
+    const vec3 _79[6] = vec3[](vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0));
+
+    uniform vec4 vs_packed_params[5];
+    layout(location = 0) in ivec4 a_packed;
+    layout(location = 0) out vec2 v_texcoord;
+    layout(location = 1) flat out vec2 v_tile;
+
+    void main()
+    {
+        vec3 _22 = vec3(a_packed.xyz) * vs_packed_params[4].w;
+        gl_Position = mat4(vs_packed_params[0], vs_packed_params[1], vs_packed_params[2], vs_packed_params[3]) * vec4(_22 + vs_packed_params[4].xyz, 1.0);
+        int _44 = a_packed.w & 255;
+        int _50 = (a_packed.w >> 8) & 3;
+        int _55 = (a_packed.w >> 10) & 7;
+        if (_55 == 0)
+        {
+            v_texcoord = vec2(float((_50 == 1) || (_50 == 2)), float(_50 >= 2));
+        }
+        else
+        {
+            int _89 = _55 - 1;
+            v_texcoord = vec2(dot(_22, _70[_89]), dot(_22, _79[_89]));
+        }
+        v_tile = vec2(float(_44 & 15), float(_44 >> 4));
+    }
+
+*/
+static const uint8_t vs_packed_source_glsl430[1100] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x34,0x33,0x30,0x0a,0x0a,0x63,0x6f,
+    0x6e,0x73,0x74,0x20,0x76,0x65,0x63,0x33,0x20,0x5f,0x37,0x30,0x5b,0x36,0x5d,0x20,
+    0x3d,0x20,0x76,0x65,0x63,0x33,0x5b,0x5d,0x28,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,
+    0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,
+    0x63,0x33,0x28,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,
+    0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,
+    0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,
+    0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x29,0x2c,0x20,0x76,
+    0x65,0x63,0x33,0x28,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,
+    0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,
+    0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x29,0x3b,0x0a,0x63,0x6f,0x6e,0x73,0x74,0x20,
+    0x76,0x65,0x63,0x33,0x20,0x5f,0x37,0x39,0x5b,0x36,0x5d,0x20,0x3d,0x20,0x76,0x65,
+    0x63,0x33,0x5b,0x5d,0x28,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x2d,
+    0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,
+    0x30,0x2e,0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,
+    0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x2c,
+    0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,
+    0x20,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,
+    0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,
+    0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,
+    0x20,0x2d,0x31,0x2e,0x30,0x29,0x29,0x3b,0x0a,0x0a,0x75,0x6e,0x69,0x66,0x6f,0x72,
+    0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x76,0x73,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,
+    0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x35,0x5d,0x3b,0x0a,0x6c,0x61,0x79,0x6f,
+    0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,
+    0x20,0x69,0x6e,0x20,0x69,0x76,0x65,0x63,0x34,0x20,0x61,0x5f,0x70,0x61,0x63,0x6b,
+    0x65,0x64,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,
+    0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,
+    0x32,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x3b,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,
+    0x31,0x29,0x20,0x66,0x6c,0x61,0x74,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x32,
+    0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x6d,
+    0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,
+    0x20,0x5f,0x32,0x32,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x61,0x5f,0x70,0x61,
+    0x63,0x6b,0x65,0x64,0x2e,0x78,0x79,0x7a,0x29,0x20,0x2a,0x20,0x76,0x73,0x5f,0x70,
+    0x61,0x63,0x6b,0x65,0x64,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x2e,
+    0x77,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,
+    0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x61,0x74,0x34,0x28,0x76,0x73,0x5f,0x70,0x61,0x63,
+    0x6b,0x65,0x64,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x30,0x5d,0x2c,0x20,0x76,
+    0x73,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,
+    0x31,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x5f,0x70,0x61,
+    0x72,0x61,0x6d,0x73,0x5b,0x32,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x70,0x61,0x63,0x6b,
+    0x65,0x64,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x33,0x5d,0x29,0x20,0x2a,0x20,
+    0x76,0x65,0x63,0x34,0x28,0x5f,0x32,0x32,0x20,0x2b,0x20,0x76,0x73,0x5f,0x70,0x61,
+    0x63,0x6b,0x65,0x64,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x2e,0x78,
+    0x79,0x7a,0x2c,0x20,0x31,0x2e,0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,
+    0x74,0x20,0x5f,0x34,0x34,0x20,0x3d,0x20,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,
+    0x2e,0x77,0x20,0x26,0x20,0x32,0x35,0x35,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,
+    0x74,0x20,0x5f,0x35,0x30,0x20,0x3d,0x20,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,
+    0x64,0x2e,0x77,0x20,0x3e,0x3e,0x20,0x38,0x29,0x20,0x26,0x20,0x33,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x35,0x35,0x20,0x3d,0x20,0x28,0x61,0x5f,
+    0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,0x3e,0x3e,0x20,0x31,0x30,0x29,0x20,
+    0x26,0x20,0x37,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x5f,0x35,0x35,
+    0x20,0x3d,0x3d,0x20,0x30,0x29,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,
+    0x3d,0x20,0x76,0x65,0x63,0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x28,0x5f,0x35,
+    0x30,0x20,0x3d,0x3d,0x20,0x31,0x29,0x20,0x7c,0x7c,0x20,0x28,0x5f,0x35,0x30,0x20,
+    0x3d,0x3d,0x20,0x32,0x29,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x35,
+    0x30,0x20,0x3e,0x3d,0x20,0x32,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,
+    0x20,0x20,0x20,0x20,0x65,0x6c,0x73,0x65,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x38,0x39,0x20,0x3d,
+    0x20,0x5f,0x35,0x35,0x20,0x2d,0x20,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x76,
+    0x65,0x63,0x32,0x28,0x64,0x6f,0x74,0x28,0x5f,0x32,0x32,0x2c,0x20,0x5f,0x37,0x30,
+    0x5b,0x5f,0x38,0x39,0x5d,0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x5f,0x32,0x32,0x2c,
+    0x20,0x5f,0x37,0x39,0x5b,0x5f,0x38,0x39,0x5d,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,
+    0x76,0x65,0x63,0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x34,0x34,0x20,0x26,
+    0x20,0x31,0x35,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x34,0x34,0x20,
+    0x3e,0x3e,0x20,0x34,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    #version 430
+
+    layout(binding = 16) uniform sampler2D tex_smp;
+
+    layout(location = 0) out vec4 frag_color;
+    layout(location = 1) flat in vec2 v_tile;
+    layout(location = 0) in vec2 v_texcoord;
+
+    void main()
+    {
+        frag_color = texture(tex_smp, (v_tile + fract(v_texcoord)) / vec2(16.0));
+    }
+
+*/
+static const uint8_t fs_tiled_source_glsl430[285] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x34,0x33,0x30,0x0a,0x0a,0x6c,0x61,
+    0x79,0x6f,0x75,0x74,0x28,0x62,0x69,0x6e,0x64,0x69,0x6e,0x67,0x20,0x3d,0x20,0x31,
+    0x36,0x29,0x20,0x75,0x6e,0x69,0x66,0x6f,0x72,0x6d,0x20,0x73,0x61,0x6d,0x70,0x6c,
+    0x65,0x72,0x32,0x44,0x20,0x74,0x65,0x78,0x5f,0x73,0x6d,0x70,0x3b,0x0a,0x0a,0x6c,
+    0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,
+    0x20,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,0x34,0x20,0x66,0x72,0x61,
+    0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,
+    0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x31,0x29,0x20,0x66,0x6c,
+    0x61,0x74,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,0x76,0x5f,0x74,0x69,0x6c,
+    0x65,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,
+    0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x69,0x6e,0x20,0x76,0x65,0x63,0x32,0x20,
+    0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x3b,0x0a,0x0a,0x76,0x6f,0x69,
+    0x64,0x20,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x65,0x78,0x74,
+    0x75,0x72,0x65,0x28,0x74,0x65,0x78,0x5f,0x73,0x6d,0x70,0x2c,0x20,0x28,0x76,0x5f,
+    0x74,0x69,0x6c,0x65,0x20,0x2b,0x20,0x66,0x72,0x61,0x63,0x74,0x28,0x76,0x5f,0x74,
+    0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x29,0x29,0x20,0x2f,0x20,0x76,0x65,0x63,0x32,
+    0x28,0x31,0x36,0x2e,0x30,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
+/*
+    #version 430
+
+    const vec3 _110[6] = vec3[](vec3(1.0, 0.0, 0.0), vec3(-1.0, 0.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0), vec3(1.0, 0.0, 0.0), vec3(1.0, 0.0, 0.0));
+    const vec3 _119[6] = vec3[](vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, -1.0, 0.0), vec3(0.0, 0.0, 1.0), vec3(0.0, 0.0, -1.0));
+
+    uniform vec4 vs_waves_params[6];
+    layout(location = 0) in ivec4 a_packed;
+    layout(location = 0) out vec2 v_texcoord;
+    layout(location = 1) flat out vec2 v_tile;
+
+    void main()
+    {
+        vec3 _22 = vec3(a_packed.xyz) * vs_waves_params[4].w;
+        vec3 _35 = _22 + vs_waves_params[4].xyz;
+        float _44 = vs_waves_params[5].x * vs_waves_params[5].w;
+        _35.y += (vs_waves_params[5].y * (sin((_35.x * vs_waves_params[5].z) + _44) + cos((_35.z * vs_waves_params[5].z) + (_44 * 1.2000000476837158203125))));
+        gl_Position = mat4(vs_waves_params[0], vs_waves_params[1], vs_waves_params[2], vs_waves_params[3]) * vec4(_35, 1.0);
+        int _84 = a_packed.w & 255;
+        int _90 = (a_packed.w >> 8) & 3;
+        int _95 = (a_packed.w >> 10) & 7;
+        if (_95 == 0)
+        {
+            v_texcoord = vec2(float((_90 == 1) || (_90 == 2)), float(_90 >= 2));
+        }
+        else
+        {
+            int _129 = _95 - 1;
+            v_texcoord = vec2(dot(_22, _110[_129]), dot(_22, _119[_129]));
+        }
+        v_tile = vec2(float(_84 & 15), float(_84 >> 4));
+    }
+
+*/
+static const uint8_t vs_waves_source_glsl430[1337] = {
+    0x23,0x76,0x65,0x72,0x73,0x69,0x6f,0x6e,0x20,0x34,0x33,0x30,0x0a,0x0a,0x63,0x6f,
+    0x6e,0x73,0x74,0x20,0x76,0x65,0x63,0x33,0x20,0x5f,0x31,0x31,0x30,0x5b,0x36,0x5d,
+    0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x5b,0x5d,0x28,0x76,0x65,0x63,0x33,0x28,0x31,
+    0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,
+    0x65,0x63,0x33,0x28,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x30,
+    0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x30,
+    0x2e,0x30,0x2c,0x20,0x31,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,
+    0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x29,0x2c,0x20,
+    0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x30,
+    0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x31,0x2e,0x30,0x2c,0x20,0x30,
+    0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x29,0x3b,0x0a,0x63,0x6f,0x6e,0x73,0x74,
+    0x20,0x76,0x65,0x63,0x33,0x20,0x5f,0x31,0x31,0x39,0x5b,0x36,0x5d,0x20,0x3d,0x20,
+    0x76,0x65,0x63,0x33,0x5b,0x5d,0x28,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,
+    0x20,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,
+    0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,
+    0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x2d,0x31,0x2e,
+    0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,
+    0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x29,0x2c,0x20,0x76,
+    0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,0x30,0x2c,0x20,0x31,0x2e,
+    0x30,0x29,0x2c,0x20,0x76,0x65,0x63,0x33,0x28,0x30,0x2e,0x30,0x2c,0x20,0x30,0x2e,
+    0x30,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x29,0x29,0x3b,0x0a,0x0a,0x75,0x6e,0x69,0x66,
+    0x6f,0x72,0x6d,0x20,0x76,0x65,0x63,0x34,0x20,0x76,0x73,0x5f,0x77,0x61,0x76,0x65,
+    0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x36,0x5d,0x3b,0x0a,0x6c,0x61,0x79,
+    0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,
+    0x29,0x20,0x69,0x6e,0x20,0x69,0x76,0x65,0x63,0x34,0x20,0x61,0x5f,0x70,0x61,0x63,
+    0x6b,0x65,0x64,0x3b,0x0a,0x6c,0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,
+    0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x30,0x29,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,
+    0x63,0x32,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x3b,0x0a,0x6c,
+    0x61,0x79,0x6f,0x75,0x74,0x28,0x6c,0x6f,0x63,0x61,0x74,0x69,0x6f,0x6e,0x20,0x3d,
+    0x20,0x31,0x29,0x20,0x66,0x6c,0x61,0x74,0x20,0x6f,0x75,0x74,0x20,0x76,0x65,0x63,
+    0x32,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,
+    0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,
+    0x33,0x20,0x5f,0x32,0x32,0x20,0x3d,0x20,0x76,0x65,0x63,0x33,0x28,0x61,0x5f,0x70,
+    0x61,0x63,0x6b,0x65,0x64,0x2e,0x78,0x79,0x7a,0x29,0x20,0x2a,0x20,0x76,0x73,0x5f,
+    0x77,0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x2e,
+    0x77,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x63,0x33,0x20,0x5f,0x33,0x35,0x20,
+    0x3d,0x20,0x5f,0x32,0x32,0x20,0x2b,0x20,0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,
+    0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x34,0x5d,0x2e,0x78,0x79,0x7a,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x20,0x5f,0x34,0x34,0x20,0x3d,0x20,
+    0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,
+    0x35,0x5d,0x2e,0x78,0x20,0x2a,0x20,0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,0x5f,
+    0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x35,0x5d,0x2e,0x77,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x5f,0x33,0x35,0x2e,0x79,0x20,0x2b,0x3d,0x20,0x28,0x76,0x73,0x5f,0x77,0x61,
+    0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x35,0x5d,0x2e,0x79,0x20,
+    0x2a,0x20,0x28,0x73,0x69,0x6e,0x28,0x28,0x5f,0x33,0x35,0x2e,0x78,0x20,0x2a,0x20,
+    0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,
+    0x35,0x5d,0x2e,0x7a,0x29,0x20,0x2b,0x20,0x5f,0x34,0x34,0x29,0x20,0x2b,0x20,0x63,
+    0x6f,0x73,0x28,0x28,0x5f,0x33,0x35,0x2e,0x7a,0x20,0x2a,0x20,0x76,0x73,0x5f,0x77,
+    0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x35,0x5d,0x2e,0x7a,
+    0x29,0x20,0x2b,0x20,0x28,0x5f,0x34,0x34,0x20,0x2a,0x20,0x31,0x2e,0x32,0x30,0x30,
+    0x30,0x30,0x30,0x30,0x34,0x37,0x36,0x38,0x33,0x37,0x31,0x35,0x38,0x32,0x30,0x33,
+    0x31,0x32,0x35,0x29,0x29,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,
+    0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x61,0x74,0x34,0x28,
+    0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,
+    0x30,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,
+    0x61,0x6d,0x73,0x5b,0x31,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x77,0x61,0x76,0x65,0x73,
+    0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x32,0x5d,0x2c,0x20,0x76,0x73,0x5f,0x77,
+    0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x5b,0x33,0x5d,0x29,0x20,
+    0x2a,0x20,0x76,0x65,0x63,0x34,0x28,0x5f,0x33,0x35,0x2c,0x20,0x31,0x2e,0x30,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x38,0x34,0x20,0x3d,0x20,
+    0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,0x26,0x20,0x32,0x35,0x35,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x39,0x30,0x20,0x3d,0x20,
+    0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,0x3e,0x3e,0x20,0x38,
+    0x29,0x20,0x26,0x20,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,
+    0x39,0x35,0x20,0x3d,0x20,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,
+    0x20,0x3e,0x3e,0x20,0x31,0x30,0x29,0x20,0x26,0x20,0x37,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x69,0x66,0x20,0x28,0x5f,0x39,0x35,0x20,0x3d,0x3d,0x20,0x30,0x29,0x0a,0x20,
+    0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,
+    0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x76,0x65,0x63,0x32,0x28,0x66,
+    0x6c,0x6f,0x61,0x74,0x28,0x28,0x5f,0x39,0x30,0x20,0x3d,0x3d,0x20,0x31,0x29,0x20,
+    0x7c,0x7c,0x20,0x28,0x5f,0x39,0x30,0x20,0x3d,0x3d,0x20,0x32,0x29,0x29,0x2c,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x39,0x30,0x20,0x3e,0x3d,0x20,0x32,0x29,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x65,0x6c,0x73,0x65,
+    0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x69,
+    0x6e,0x74,0x20,0x5f,0x31,0x32,0x39,0x20,0x3d,0x20,0x5f,0x39,0x35,0x20,0x2d,0x20,
+    0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x65,0x78,
+    0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x76,0x65,0x63,0x32,0x28,0x64,0x6f,0x74,
+    0x28,0x5f,0x32,0x32,0x2c,0x20,0x5f,0x31,0x31,0x30,0x5b,0x5f,0x31,0x32,0x39,0x5d,
+    0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x5f,0x32,0x32,0x2c,0x20,0x5f,0x31,0x31,0x39,
+    0x5b,0x5f,0x31,0x32,0x39,0x5d,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,
+    0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,0x76,0x65,0x63,
+    0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x38,0x34,0x20,0x26,0x20,0x31,0x35,
+    0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x38,0x34,0x20,0x3e,0x3e,0x20,
+    0x34,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x00,
+};
 /*
     cbuffer vs_params : register(b0)
     {
@@ -275,6 +565,434 @@ static const uint8_t fs_source_hlsl5[549] = {
     0x75,0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,
     0x3b,0x0a,0x7d,0x0a,0x00,
 };
+/*
+    static const float3 _70[6] = { float3(1.0f, 0.0f, 0.0f), float3(-1.0f, 0.0f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(0.0f, 0.0f, -1.0f), float3(1.0f, 0.0f, 0.0f), float3(1.0f, 0.0f, 0.0f) };
+    static const float3 _79[6] = { float3(0.0f, -1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(0.0f, 0.0f, -1.0f) };
+
+    cbuffer vs_packed_params : register(b0)
+    {
+        row_major float4x4 _28_mvp : packoffset(c0);
+        float4 _28_origin_scale : packoffset(c4);
+    };
+
+
+    static float4 gl_Position;
+    static int4 a_packed;
+    static float2 v_texcoord;
+    static float2 v_tile;
+
+    struct SPIRV_Cross_Input
+    {
+        int4 a_packed : TEXCOORD0;
+    };
+
+    struct SPIRV_Cross_Output
+    {
+        float2 v_texcoord : TEXCOORD0;
+        nointerpolation float2 v_tile : TEXCOORD1;
+        float4 gl_Position : SV_Position;
+    };
+
+    void vert_main()
+    {
+        float3 _22 = float3(a_packed.xyz) * _28_origin_scale.w;
+        gl_Position = mul(float4(_22 + _28_origin_scale.xyz, 1.0f), _28_mvp);
+        int _44 = a_packed.w & 255;
+        int _50 = (a_packed.w >> 8) & 3;
+        int _55 = (a_packed.w >> 10) & 7;
+        if (_55 == 0)
+        {
+            v_texcoord = float2(float((_50 == 1) || (_50 == 2)), float(_50 >= 2));
+        }
+        else
+        {
+            int _89 = _55 - 1;
+            v_texcoord = float2(dot(_22, _70[_89]), dot(_22, _79[_89]));
+        }
+        v_tile = float2(float(_44 & 15), float(_44 >> 4));
+    }
+
+    SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+    {
+        a_packed = stage_input.a_packed;
+        vert_main();
+        SPIRV_Cross_Output stage_output;
+        stage_output.gl_Position = gl_Position;
+        stage_output.v_texcoord = v_texcoord;
+        stage_output.v_tile = v_tile;
+        return stage_output;
+    }
+*/
+static const uint8_t vs_packed_source_hlsl5[1680] = {
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x33,0x20,0x5f,0x37,0x30,0x5b,0x36,0x5d,0x20,0x3d,0x20,0x7b,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x33,0x28,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,
+    0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,
+    0x2d,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,
+    0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,
+    0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,
+    0x20,0x2d,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,
+    0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,
+    0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x31,0x2e,0x30,0x66,0x2c,0x20,
+    0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x20,0x7d,0x3b,0x0a,0x73,
+    0x74,0x61,0x74,0x69,0x63,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x33,0x20,0x5f,0x37,0x39,0x5b,0x36,0x5d,0x20,0x3d,0x20,0x7b,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,
+    0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,
+    0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,
+    0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,
+    0x20,0x2d,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,
+    0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,
+    0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,
+    0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,
+    0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,0x29,0x20,0x7d,0x3b,
+    0x0a,0x0a,0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x76,0x73,0x5f,0x70,0x61,0x63,
+    0x6b,0x65,0x64,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x20,0x3a,0x20,0x72,0x65,0x67,
+    0x69,0x73,0x74,0x65,0x72,0x28,0x62,0x30,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,
+    0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x78,0x34,0x20,0x5f,0x32,0x38,0x5f,0x6d,0x76,0x70,0x20,0x3a,0x20,0x70,0x61,0x63,
+    0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x30,0x29,0x3b,0x0a,0x20,0x20,0x20,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x5f,0x32,0x38,0x5f,0x6f,0x72,0x69,0x67,
+    0x69,0x6e,0x5f,0x73,0x63,0x61,0x6c,0x65,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,
+    0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x34,0x29,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x0a,
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x69,0x6e,0x74,0x34,0x20,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x3b,
+    0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,
+    0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,
+    0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x3b,
+    0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,
+    0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x69,0x6e,0x74,0x34,0x20,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x20,0x3a,
+    0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,
+    0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,
+    0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,
+    0x64,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,
+    0x20,0x20,0x20,0x6e,0x6f,0x69,0x6e,0x74,0x65,0x72,0x70,0x6f,0x6c,0x61,0x74,0x69,
+    0x6f,0x6e,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,
+    0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,
+    0x74,0x69,0x6f,0x6e,0x20,0x3a,0x20,0x53,0x56,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,
+    0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x76,0x65,0x72,
+    0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x33,0x20,0x5f,0x32,0x32,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x33,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x78,0x79,0x7a,0x29,
+    0x20,0x2a,0x20,0x5f,0x32,0x38,0x5f,0x6f,0x72,0x69,0x67,0x69,0x6e,0x5f,0x73,0x63,
+    0x61,0x6c,0x65,0x2e,0x77,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x75,0x6c,0x28,0x66,0x6c,0x6f,
+    0x61,0x74,0x34,0x28,0x5f,0x32,0x32,0x20,0x2b,0x20,0x5f,0x32,0x38,0x5f,0x6f,0x72,
+    0x69,0x67,0x69,0x6e,0x5f,0x73,0x63,0x61,0x6c,0x65,0x2e,0x78,0x79,0x7a,0x2c,0x20,
+    0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x5f,0x32,0x38,0x5f,0x6d,0x76,0x70,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x34,0x34,0x20,0x3d,0x20,0x61,
+    0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,0x26,0x20,0x32,0x35,0x35,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x35,0x30,0x20,0x3d,0x20,0x28,
+    0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,0x3e,0x3e,0x20,0x38,0x29,
+    0x20,0x26,0x20,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x35,
+    0x35,0x20,0x3d,0x20,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,
+    0x3e,0x3e,0x20,0x31,0x30,0x29,0x20,0x26,0x20,0x37,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x69,0x66,0x20,0x28,0x5f,0x35,0x35,0x20,0x3d,0x3d,0x20,0x30,0x29,0x0a,0x20,0x20,
+    0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x65,
+    0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,
+    0x66,0x6c,0x6f,0x61,0x74,0x28,0x28,0x5f,0x35,0x30,0x20,0x3d,0x3d,0x20,0x31,0x29,
+    0x20,0x7c,0x7c,0x20,0x28,0x5f,0x35,0x30,0x20,0x3d,0x3d,0x20,0x32,0x29,0x29,0x2c,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x35,0x30,0x20,0x3e,0x3d,0x20,0x32,0x29,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x65,0x6c,0x73,
+    0x65,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x69,0x6e,0x74,0x20,0x5f,0x38,0x39,0x20,0x3d,0x20,0x5f,0x35,0x35,0x20,0x2d,0x20,
+    0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x65,0x78,
+    0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x64,
+    0x6f,0x74,0x28,0x5f,0x32,0x32,0x2c,0x20,0x5f,0x37,0x30,0x5b,0x5f,0x38,0x39,0x5d,
+    0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x5f,0x32,0x32,0x2c,0x20,0x5f,0x37,0x39,0x5b,
+    0x5f,0x38,0x39,0x5d,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,
+    0x20,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x34,0x34,0x20,0x26,0x20,0x31,0x35,
+    0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x34,0x34,0x20,0x3e,0x3e,0x20,
+    0x34,0x29,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,
+    0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x28,
+    0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,
+    0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,0x7b,
+    0x0a,0x20,0x20,0x20,0x20,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x20,0x3d,0x20,
+    0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x5f,0x70,0x61,
+    0x63,0x6b,0x65,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,
+    0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x53,0x50,0x49,0x52,0x56,
+    0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x67,0x6c,0x5f,
+    0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3d,0x20,0x67,0x6c,0x5f,0x50,0x6f,
+    0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,
+    0x6f,0x72,0x64,0x20,0x3d,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,
+    0x75,0x74,0x2e,0x76,0x5f,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,0x76,0x5f,0x74,0x69,
+    0x6c,0x65,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,
+    0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
+/*
+    Texture2D<float4> tex : register(t0);
+    SamplerState smp : register(s0);
+
+    static float4 frag_color;
+    static float2 v_tile;
+    static float2 v_texcoord;
+
+    struct SPIRV_Cross_Input
+    {
+        float2 v_texcoord : TEXCOORD0;
+        nointerpolation float2 v_tile : TEXCOORD1;
+    };
+
+    struct SPIRV_Cross_Output
+    {
+        float4 frag_color : SV_Target0;
+    };
+
+    void frag_main()
+    {
+        frag_color = tex.Sample(smp, (v_tile + frac(v_texcoord)) / 16.0f.xx);
+    }
+
+    SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+    {
+        v_tile = stage_input.v_tile;
+        v_texcoord = stage_input.v_texcoord;
+        frag_main();
+        SPIRV_Cross_Output stage_output;
+        stage_output.frag_color = frag_color;
+        return stage_output;
+    }
+*/
+static const uint8_t fs_tiled_source_hlsl5[679] = {
+    0x54,0x65,0x78,0x74,0x75,0x72,0x65,0x32,0x44,0x3c,0x66,0x6c,0x6f,0x61,0x74,0x34,
+    0x3e,0x20,0x74,0x65,0x78,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,0x72,
+    0x28,0x74,0x30,0x29,0x3b,0x0a,0x53,0x61,0x6d,0x70,0x6c,0x65,0x72,0x53,0x74,0x61,
+    0x74,0x65,0x20,0x73,0x6d,0x70,0x20,0x3a,0x20,0x72,0x65,0x67,0x69,0x73,0x74,0x65,
+    0x72,0x28,0x73,0x30,0x29,0x3b,0x0a,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,
+    0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,
+    0x76,0x5f,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,
+    0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x0a,0x7b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,
+    0x6f,0x72,0x64,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x30,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x6e,0x6f,0x69,0x6e,0x74,0x65,0x72,0x70,0x6f,0x6c,0x61,
+    0x74,0x69,0x6f,0x6e,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x69,
+    0x6c,0x65,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,0x31,0x3b,0x0a,
+    0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,0x49,0x52,0x56,
+    0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x0a,0x7b,0x0a,
+    0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x66,0x72,0x61,0x67,0x5f,
+    0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3a,0x20,0x53,0x56,0x5f,0x54,0x61,0x72,0x67,0x65,
+    0x74,0x30,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x76,0x6f,0x69,0x64,0x20,0x66,0x72,0x61,
+    0x67,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x74,0x65,0x78,0x2e,
+    0x53,0x61,0x6d,0x70,0x6c,0x65,0x28,0x73,0x6d,0x70,0x2c,0x20,0x28,0x76,0x5f,0x74,
+    0x69,0x6c,0x65,0x20,0x2b,0x20,0x66,0x72,0x61,0x63,0x28,0x76,0x5f,0x74,0x65,0x78,
+    0x63,0x6f,0x6f,0x72,0x64,0x29,0x29,0x20,0x2f,0x20,0x31,0x36,0x2e,0x30,0x66,0x2e,
+    0x78,0x78,0x29,0x3b,0x0a,0x7d,0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,
+    0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x28,
+    0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,
+    0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,0x7b,
+    0x0a,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x20,0x3d,0x20,0x73,0x74,
+    0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x76,0x5f,0x74,0x69,0x6c,0x65,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,
+    0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x2e,0x76,
+    0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,
+    0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,
+    0x74,0x2e,0x66,0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x20,0x3d,0x20,0x66,
+    0x72,0x61,0x67,0x5f,0x63,0x6f,0x6c,0x6f,0x72,0x3b,0x0a,0x20,0x20,0x20,0x20,0x72,
+    0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,
+    0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
+/*
+    static const float3 _110[6] = { float3(1.0f, 0.0f, 0.0f), float3(-1.0f, 0.0f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(0.0f, 0.0f, -1.0f), float3(1.0f, 0.0f, 0.0f), float3(1.0f, 0.0f, 0.0f) };
+    static const float3 _119[6] = { float3(0.0f, -1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f), float3(0.0f, -1.0f, 0.0f), float3(0.0f, 0.0f, 1.0f), float3(0.0f, 0.0f, -1.0f) };
+
+    cbuffer vs_waves_params : register(b0)
+    {
+        row_major float4x4 _28_mvp : packoffset(c0);
+        float4 _28_origin_scale : packoffset(c4);
+        float4 _28_wave : packoffset(c5);
+    };
+
+
+    static float4 gl_Position;
+    static int4 a_packed;
+    static float2 v_texcoord;
+    static float2 v_tile;
+
+    struct SPIRV_Cross_Input
+    {
+        int4 a_packed : TEXCOORD0;
+    };
+
+    struct SPIRV_Cross_Output
+    {
+        float2 v_texcoord : TEXCOORD0;
+        nointerpolation float2 v_tile : TEXCOORD1;
+        float4 gl_Position : SV_Position;
+    };
+
+    void vert_main()
+    {
+        float3 _22 = float3(a_packed.xyz) * _28_origin_scale.w;
+        float3 _35 = _22 + _28_origin_scale.xyz;
+        float _44 = _28_wave.x * _28_wave.w;
+        _35.y += (_28_wave.y * (sin((_35.x * _28_wave.z) + _44) + cos((_35.z * _28_wave.z) + (_44 * 1.2000000476837158203125f))));
+        gl_Position = mul(float4(_35, 1.0f), _28_mvp);
+        int _84 = a_packed.w & 255;
+        int _90 = (a_packed.w >> 8) & 3;
+        int _95 = (a_packed.w >> 10) & 7;
+        if (_95 == 0)
+        {
+            v_texcoord = float2(float((_90 == 1) || (_90 == 2)), float(_90 >= 2));
+        }
+        else
+        {
+            int _129 = _95 - 1;
+            v_texcoord = float2(dot(_22, _110[_129]), dot(_22, _119[_129]));
+        }
+        v_tile = float2(float(_84 & 15), float(_84 >> 4));
+    }
+
+    SPIRV_Cross_Output main(SPIRV_Cross_Input stage_input)
+    {
+        a_packed = stage_input.a_packed;
+        vert_main();
+        SPIRV_Cross_Output stage_output;
+        stage_output.gl_Position = gl_Position;
+        stage_output.v_texcoord = v_texcoord;
+        stage_output.v_tile = v_tile;
+        return stage_output;
+    }
+*/
+static const uint8_t vs_waves_source_hlsl5[1914] = {
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x33,0x20,0x5f,0x31,0x31,0x30,0x5b,0x36,0x5d,0x20,0x3d,0x20,0x7b,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,
+    0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,
+    0x28,0x2d,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,
+    0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,
+    0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,
+    0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,
+    0x28,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,
+    0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x31,0x2e,0x30,0x66,0x2c,
+    0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x20,0x7d,0x3b,0x0a,
+    0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x63,0x6f,0x6e,0x73,0x74,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x33,0x20,0x5f,0x31,0x31,0x39,0x5b,0x36,0x5d,0x20,0x3d,0x20,0x7b,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,
+    0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,
+    0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,
+    0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,
+    0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,
+    0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,
+    0x74,0x33,0x28,0x30,0x2e,0x30,0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x31,
+    0x2e,0x30,0x66,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x30,0x2e,0x30,
+    0x66,0x2c,0x20,0x30,0x2e,0x30,0x66,0x2c,0x20,0x2d,0x31,0x2e,0x30,0x66,0x29,0x20,
+    0x7d,0x3b,0x0a,0x0a,0x63,0x62,0x75,0x66,0x66,0x65,0x72,0x20,0x76,0x73,0x5f,0x77,
+    0x61,0x76,0x65,0x73,0x5f,0x70,0x61,0x72,0x61,0x6d,0x73,0x20,0x3a,0x20,0x72,0x65,
+    0x67,0x69,0x73,0x74,0x65,0x72,0x28,0x62,0x30,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x72,0x6f,0x77,0x5f,0x6d,0x61,0x6a,0x6f,0x72,0x20,0x66,0x6c,0x6f,0x61,0x74,
+    0x34,0x78,0x34,0x20,0x5f,0x32,0x38,0x5f,0x6d,0x76,0x70,0x20,0x3a,0x20,0x70,0x61,
+    0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x30,0x29,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x5f,0x32,0x38,0x5f,0x6f,0x72,0x69,
+    0x67,0x69,0x6e,0x5f,0x73,0x63,0x61,0x6c,0x65,0x20,0x3a,0x20,0x70,0x61,0x63,0x6b,
+    0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x34,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,0x5f,0x32,0x38,0x5f,0x77,0x61,0x76,0x65,0x20,
+    0x3a,0x20,0x70,0x61,0x63,0x6b,0x6f,0x66,0x66,0x73,0x65,0x74,0x28,0x63,0x35,0x29,
+    0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x34,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,
+    0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x69,0x6e,0x74,0x34,0x20,0x61,0x5f,
+    0x70,0x61,0x63,0x6b,0x65,0x64,0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,
+    0x3b,0x0a,0x73,0x74,0x61,0x74,0x69,0x63,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,
+    0x76,0x5f,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,
+    0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,
+    0x74,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x34,0x20,0x61,0x5f,0x70,
+    0x61,0x63,0x6b,0x65,0x64,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,0x52,0x44,
+    0x30,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x73,0x74,0x72,0x75,0x63,0x74,0x20,0x53,0x50,
+    0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,
+    0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x20,0x76,0x5f,
+    0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,
+    0x4f,0x52,0x44,0x30,0x3b,0x0a,0x20,0x20,0x20,0x20,0x6e,0x6f,0x69,0x6e,0x74,0x65,
+    0x72,0x70,0x6f,0x6c,0x61,0x74,0x69,0x6f,0x6e,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,
+    0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x20,0x3a,0x20,0x54,0x45,0x58,0x43,0x4f,0x4f,
+    0x52,0x44,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x34,0x20,
+    0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x20,0x3a,0x20,0x53,0x56,
+    0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,0x3b,0x0a,0x7d,0x3b,0x0a,0x0a,0x76,
+    0x6f,0x69,0x64,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x0a,
+    0x7b,0x0a,0x20,0x20,0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x5f,0x32,0x32,
+    0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,
+    0x65,0x64,0x2e,0x78,0x79,0x7a,0x29,0x20,0x2a,0x20,0x5f,0x32,0x38,0x5f,0x6f,0x72,
+    0x69,0x67,0x69,0x6e,0x5f,0x73,0x63,0x61,0x6c,0x65,0x2e,0x77,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x66,0x6c,0x6f,0x61,0x74,0x33,0x20,0x5f,0x33,0x35,0x20,0x3d,0x20,0x5f,
+    0x32,0x32,0x20,0x2b,0x20,0x5f,0x32,0x38,0x5f,0x6f,0x72,0x69,0x67,0x69,0x6e,0x5f,
+    0x73,0x63,0x61,0x6c,0x65,0x2e,0x78,0x79,0x7a,0x3b,0x0a,0x20,0x20,0x20,0x20,0x66,
+    0x6c,0x6f,0x61,0x74,0x20,0x5f,0x34,0x34,0x20,0x3d,0x20,0x5f,0x32,0x38,0x5f,0x77,
+    0x61,0x76,0x65,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x32,0x38,0x5f,0x77,0x61,0x76,0x65,
+    0x2e,0x77,0x3b,0x0a,0x20,0x20,0x20,0x20,0x5f,0x33,0x35,0x2e,0x79,0x20,0x2b,0x3d,
+    0x20,0x28,0x5f,0x32,0x38,0x5f,0x77,0x61,0x76,0x65,0x2e,0x79,0x20,0x2a,0x20,0x28,
+    0x73,0x69,0x6e,0x28,0x28,0x5f,0x33,0x35,0x2e,0x78,0x20,0x2a,0x20,0x5f,0x32,0x38,
+    0x5f,0x77,0x61,0x76,0x65,0x2e,0x7a,0x29,0x20,0x2b,0x20,0x5f,0x34,0x34,0x29,0x20,
+    0x2b,0x20,0x63,0x6f,0x73,0x28,0x28,0x5f,0x33,0x35,0x2e,0x7a,0x20,0x2a,0x20,0x5f,
+    0x32,0x38,0x5f,0x77,0x61,0x76,0x65,0x2e,0x7a,0x29,0x20,0x2b,0x20,0x28,0x5f,0x34,
+    0x34,0x20,0x2a,0x20,0x31,0x2e,0x32,0x30,0x30,0x30,0x30,0x30,0x30,0x34,0x37,0x36,
+    0x38,0x33,0x37,0x31,0x35,0x38,0x32,0x30,0x33,0x31,0x32,0x35,0x66,0x29,0x29,0x29,
+    0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,
+    0x6f,0x6e,0x20,0x3d,0x20,0x6d,0x75,0x6c,0x28,0x66,0x6c,0x6f,0x61,0x74,0x34,0x28,
+    0x5f,0x33,0x35,0x2c,0x20,0x31,0x2e,0x30,0x66,0x29,0x2c,0x20,0x5f,0x32,0x38,0x5f,
+    0x6d,0x76,0x70,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x38,
+    0x34,0x20,0x3d,0x20,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,0x26,
+    0x20,0x32,0x35,0x35,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x39,
+    0x30,0x20,0x3d,0x20,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x2e,0x77,0x20,
+    0x3e,0x3e,0x20,0x38,0x29,0x20,0x26,0x20,0x33,0x3b,0x0a,0x20,0x20,0x20,0x20,0x69,
+    0x6e,0x74,0x20,0x5f,0x39,0x35,0x20,0x3d,0x20,0x28,0x61,0x5f,0x70,0x61,0x63,0x6b,
+    0x65,0x64,0x2e,0x77,0x20,0x3e,0x3e,0x20,0x31,0x30,0x29,0x20,0x26,0x20,0x37,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x69,0x66,0x20,0x28,0x5f,0x39,0x35,0x20,0x3d,0x3d,0x20,
+    0x30,0x29,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x32,0x28,0x66,0x6c,0x6f,0x61,0x74,0x28,0x28,0x5f,0x39,0x30,0x20,
+    0x3d,0x3d,0x20,0x31,0x29,0x20,0x7c,0x7c,0x20,0x28,0x5f,0x39,0x30,0x20,0x3d,0x3d,
+    0x20,0x32,0x29,0x29,0x2c,0x20,0x66,0x6c,0x6f,0x61,0x74,0x28,0x5f,0x39,0x30,0x20,
+    0x3e,0x3d,0x20,0x32,0x29,0x29,0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,
+    0x20,0x20,0x65,0x6c,0x73,0x65,0x0a,0x20,0x20,0x20,0x20,0x7b,0x0a,0x20,0x20,0x20,
+    0x20,0x20,0x20,0x20,0x20,0x69,0x6e,0x74,0x20,0x5f,0x31,0x32,0x39,0x20,0x3d,0x20,
+    0x5f,0x39,0x35,0x20,0x2d,0x20,0x31,0x3b,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
+    0x20,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,0x66,0x6c,
+    0x6f,0x61,0x74,0x32,0x28,0x64,0x6f,0x74,0x28,0x5f,0x32,0x32,0x2c,0x20,0x5f,0x31,
+    0x31,0x30,0x5b,0x5f,0x31,0x32,0x39,0x5d,0x29,0x2c,0x20,0x64,0x6f,0x74,0x28,0x5f,
+    0x32,0x32,0x2c,0x20,0x5f,0x31,0x31,0x39,0x5b,0x5f,0x31,0x32,0x39,0x5d,0x29,0x29,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x7d,0x0a,0x20,0x20,0x20,0x20,0x76,0x5f,0x74,0x69,
+    0x6c,0x65,0x20,0x3d,0x20,0x66,0x6c,0x6f,0x61,0x74,0x32,0x28,0x66,0x6c,0x6f,0x61,
+    0x74,0x28,0x5f,0x38,0x34,0x20,0x26,0x20,0x31,0x35,0x29,0x2c,0x20,0x66,0x6c,0x6f,
+    0x61,0x74,0x28,0x5f,0x38,0x34,0x20,0x3e,0x3e,0x20,0x34,0x29,0x29,0x3b,0x0a,0x7d,
+    0x0a,0x0a,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,0x5f,0x4f,0x75,
+    0x74,0x70,0x75,0x74,0x20,0x6d,0x61,0x69,0x6e,0x28,0x53,0x50,0x49,0x52,0x56,0x5f,
+    0x43,0x72,0x6f,0x73,0x73,0x5f,0x49,0x6e,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,
+    0x65,0x5f,0x69,0x6e,0x70,0x75,0x74,0x29,0x0a,0x7b,0x0a,0x20,0x20,0x20,0x20,0x61,
+    0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x20,0x3d,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,
+    0x69,0x6e,0x70,0x75,0x74,0x2e,0x61,0x5f,0x70,0x61,0x63,0x6b,0x65,0x64,0x3b,0x0a,
+    0x20,0x20,0x20,0x20,0x76,0x65,0x72,0x74,0x5f,0x6d,0x61,0x69,0x6e,0x28,0x29,0x3b,
+    0x0a,0x20,0x20,0x20,0x20,0x53,0x50,0x49,0x52,0x56,0x5f,0x43,0x72,0x6f,0x73,0x73,
+    0x5f,0x4f,0x75,0x74,0x70,0x75,0x74,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,
+    0x74,0x70,0x75,0x74,0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,
+    0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,
+    0x6f,0x6e,0x20,0x3d,0x20,0x67,0x6c,0x5f,0x50,0x6f,0x73,0x69,0x74,0x69,0x6f,0x6e,
+    0x3b,0x0a,0x20,0x20,0x20,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,
+    0x75,0x74,0x2e,0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x20,0x3d,0x20,
+    0x76,0x5f,0x74,0x65,0x78,0x63,0x6f,0x6f,0x72,0x64,0x3b,0x0a,0x20,0x20,0x20,0x20,
+    0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,0x75,0x74,0x70,0x75,0x74,0x2e,0x76,0x5f,0x74,
+    0x69,0x6c,0x65,0x20,0x3d,0x20,0x76,0x5f,0x74,0x69,0x6c,0x65,0x3b,0x0a,0x20,0x20,
+    0x20,0x20,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x74,0x61,0x67,0x65,0x5f,0x6f,
+    0x75,0x74,0x70,0x75,0x74,0x3b,0x0a,0x7d,0x0a,0x00,
+};
 static inline const sg_shader_desc* textured_shader_desc(sg_backend backend) {
     if (backend == SG_BACKEND_GLCORE) {
         static sg_shader_desc desc;
@@ -347,3 +1065,137 @@ static inline const sg_shader_desc* textured_shader_desc(sg_backend backend) {
     }
     return 0;
 }
+static inline const sg_shader_desc* textured_packed_shader_desc(sg_backend backend) {
+    if (backend == SG_BACKEND_GLCORE) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_packed_source_glsl430;
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_tiled_source_glsl430;
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_SINT;
+            desc.attrs[0].glsl_name = "a_packed";
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 80;
+            desc.uniform_blocks[0].glsl_uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+            desc.uniform_blocks[0].glsl_uniforms[0].array_count = 5;
+            desc.uniform_blocks[0].glsl_uniforms[0].glsl_name = "vs_packed_params";
+            desc.images[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.images[0].image_type = SG_IMAGETYPE_2D;
+            desc.images[0].sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.images[0].multisampled = false;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.image_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.image_sampler_pairs[0].image_slot = 0;
+            desc.image_sampler_pairs[0].sampler_slot = 0;
+            desc.image_sampler_pairs[0].glsl_name = "tex_smp";
+            desc.label = "textured_packed_shader";
+        }
+        return &desc;
+    }
+    if (backend == SG_BACKEND_D3D11) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_packed_source_hlsl5;
+            desc.vertex_func.d3d11_target = "vs_5_0";
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_tiled_source_hlsl5;
+            desc.fragment_func.d3d11_target = "ps_5_0";
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_SINT;
+            desc.attrs[0].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[0].hlsl_sem_index = 0;
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 80;
+            desc.uniform_blocks[0].hlsl_register_b_n = 0;
+            desc.images[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.images[0].image_type = SG_IMAGETYPE_2D;
+            desc.images[0].sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.images[0].multisampled = false;
+            desc.images[0].hlsl_register_t_n = 0;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.samplers[0].hlsl_register_s_n = 0;
+            desc.image_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.image_sampler_pairs[0].image_slot = 0;
+            desc.image_sampler_pairs[0].sampler_slot = 0;
+            desc.label = "textured_packed_shader";
+        }
+        return &desc;
+    }
+    return 0;
+}
+static inline const sg_shader_desc* textured_waves_shader_desc(sg_backend backend) {
+    if (backend == SG_BACKEND_GLCORE) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_waves_source_glsl430;
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_tiled_source_glsl430;
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_SINT;
+            desc.attrs[0].glsl_name = "a_packed";
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 96;
+            desc.uniform_blocks[0].glsl_uniforms[0].type = SG_UNIFORMTYPE_FLOAT4;
+            desc.uniform_blocks[0].glsl_uniforms[0].array_count = 6;
+            desc.uniform_blocks[0].glsl_uniforms[0].glsl_name = "vs_waves_params";
+            desc.images[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.images[0].image_type = SG_IMAGETYPE_2D;
+            desc.images[0].sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.images[0].multisampled = false;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.image_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.image_sampler_pairs[0].image_slot = 0;
+            desc.image_sampler_pairs[0].sampler_slot = 0;
+            desc.image_sampler_pairs[0].glsl_name = "tex_smp";
+            desc.label = "textured_waves_shader";
+        }
+        return &desc;
+    }
+    if (backend == SG_BACKEND_D3D11) {
+        static sg_shader_desc desc;
+        static bool valid;
+        if (!valid) {
+            valid = true;
+            desc.vertex_func.source = (const char*)vs_waves_source_hlsl5;
+            desc.vertex_func.d3d11_target = "vs_5_0";
+            desc.vertex_func.entry = "main";
+            desc.fragment_func.source = (const char*)fs_tiled_source_hlsl5;
+            desc.fragment_func.d3d11_target = "ps_5_0";
+            desc.fragment_func.entry = "main";
+            desc.attrs[0].base_type = SG_SHADERATTRBASETYPE_SINT;
+            desc.attrs[0].hlsl_sem_name = "TEXCOORD";
+            desc.attrs[0].hlsl_sem_index = 0;
+            desc.uniform_blocks[0].stage = SG_SHADERSTAGE_VERTEX;
+            desc.uniform_blocks[0].layout = SG_UNIFORMLAYOUT_STD140;
+            desc.uniform_blocks[0].size = 96;
+            desc.uniform_blocks[0].hlsl_register_b_n = 0;
+            desc.images[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.images[0].image_type = SG_IMAGETYPE_2D;
+            desc.images[0].sample_type = SG_IMAGESAMPLETYPE_FLOAT;
+            desc.images[0].multisampled = false;
+            desc.images[0].hlsl_register_t_n = 0;
+            desc.samplers[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.samplers[0].sampler_type = SG_SAMPLERTYPE_FILTERING;
+            desc.samplers[0].hlsl_register_s_n = 0;
+            desc.image_sampler_pairs[0].stage = SG_SHADERSTAGE_FRAGMENT;
+            desc.image_sampler_pairs[0].image_slot = 0;
+            desc.image_sampler_pairs[0].sampler_slot = 0;
+            desc.label = "textured_waves_shader";
+        }
+        return &desc;
+    }
+    return 0;
+}
@@ -1,44 +1,139 @@
 #include "world_builder.h"
+#include <assert.h>
 #include <stdint.h>
+#include <string.h>
 #include "cmath.h"
 
 // Initialize the world builder
-void world_builder_init(WorldBuilder* builder, float* vertex_buffer, size_t max_vertices) {
+void world_builder_init(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices) {
     builder->vertex_buffer = vertex_buffer;
-    builder->current_index = 0;
-    builder->max_vertices = max_vertices * VERTEX_STRIDE;
+    builder->size = 0;
+    builder->stride = VERTEX_STRIDE * sizeof(float);
+    builder->capacity = max_vertices * builder->stride;
+    builder->indexed = false;
+    builder->packed = false;
+    builder->origin = (vec3){0.0f, 0.0f, 0.0f};
+    builder->position_scale = PACKED_POSITION_SCALE;
+}
+
+void world_builder_init_indexed(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices) {
+    world_builder_init(builder, vertex_buffer, max_vertices);
+    builder->indexed = true;
+}
+
+void world_builder_init_packed(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices, vec3 origin) {
+    world_builder_init_indexed(builder, vertex_buffer, max_vertices);
+    builder->stride = sizeof(Packed_Vertex);
+    builder->capacity = max_vertices * builder->stride;
+    builder->packed = true;
+    builder->origin = origin;
+}
+
+void world_builder_init_packed_scaled(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices, vec3 origin, float position_scale) {
+    world_builder_init_packed(builder, vertex_buffer, max_vertices, origin);
+    builder->position_scale = position_scale;
+}
+
+// Two CCW triangles per quad, 0-1-2 and 0-2-3
+static const uint32_t quad_pattern[QUAD_INDICES] = {0, 1, 2, 0, 2, 3};
+
+void world_builder_quad_indices16(uint16_t* indices, size_t quad_count) {
+    assert(quad_count <= MAX_QUADS_INDEX16); // Later quads would wrap around to earlier vertices
+    for (size_t quad = 0; quad < quad_count; quad++) {
+        for (int i = 0; i < QUAD_INDICES; i++) {
+            indices[quad * QUAD_INDICES + i] = (uint16_t)(quad * QUAD_VERTICES + quad_pattern[i]);
+        }
+    }
+}
+
+void world_builder_quad_indices32(uint32_t* indices, size_t quad_count) {
+    for (size_t quad = 0; quad < quad_count; quad++) {
+        for (int i = 0; i < QUAD_INDICES; i++) {
+            indices[quad * QUAD_INDICES + i] = (uint32_t)(quad * QUAD_VERTICES + quad_pattern[i]);
+        }
+    }
 }
 
 // Internal helper to add a vertex
 static void add_vertex(WorldBuilder* builder, vec3 pos, float u, float v) {
-    if (builder->current_index + VERTEX_STRIDE <= builder->max_vertices) {
-        float* ptr = builder->vertex_buffer + builder->current_index;
-        ptr[0] = pos.x;
-        ptr[1] = pos.y;
-        ptr[2] = pos.z;
-        ptr[3] = u;
-        ptr[4] = v;
-        builder->current_index += VERTEX_STRIDE;
+    if (builder->size + builder->stride <= builder->capacity) {
+        float vertex[VERTEX_STRIDE] = {pos.x, pos.y, pos.z, u, v};
+        memcpy((uint8_t*)builder->vertex_buffer + builder->size, vertex, sizeof(vertex));
+        builder->size += builder->stride;
     }
 }
 
-// Add a quad to the mesh
-void world_builder_add_quad(
-    WorldBuilder* builder,
-    vec3 start,
-    vec3 vec1,
-    vec3 vec2,
-    uint16_t tileIdx
-) {
+static int16_t quantize_position(float value, float origin, float scale) {
+    float q = roundf((value - origin) * scale);
+    assert(q >= INT16_MIN && q <= INT16_MAX); // Too far from the builder origin for its position_scale
+    return (int16_t)q;
+}
+
+// Internal helper to add a packed vertex, the shader turns tile and corner back into atlas UVs
+static void add_packed_vertex(WorldBuilder* builder, vec3 pos, uint16_t tileIdx, uint16_t corner, uint16_t face) {
+    if (builder->size + builder->stride <= builder->capacity) {
+        Packed_Vertex vertex = {
+            quantize_position(pos.x, builder->origin.x, builder->position_scale),
+            quantize_position(pos.y, builder->origin.y, builder->position_scale),
+            quantize_position(pos.z, builder->origin.z, builder->position_scale),
+            (uint16_t)((tileIdx & PACKED_TILE_MASK) | (corner << PACKED_CORNER_SHIFT) | (face << PACKED_FACE_SHIFT)),
+        };
+        memcpy((uint8_t*)builder->vertex_buffer + builder->size, &vertex, sizeof(vertex));
+        builder->size += builder->stride;
+    }
+}
+
+// Internal helper to add a quad from its corners in CCW order. Corner 0 gets the top left
+// of the atlas tile and corner 2 the bottom right. Packed builders store face (cube face + 1,
+// or 0) so the shader can tile the texture across quads larger than a block
+static void add_quad_corners(WorldBuilder* builder, const vec3 corners[4], uint16_t tileIdx, uint16_t face) {
+    size_t quad_bytes = (builder->indexed ? QUAD_VERTICES : QUAD_INDICES) * builder->stride;
+    if (builder->size + quad_bytes > builder->capacity) {
+        return; // Never leave half a quad behind, it would shift every quad after it
+    }
+    if (builder->packed) {
+        for (uint16_t i = 0; i < QUAD_VERTICES; i++) {
+            add_packed_vertex(builder, corners[i], tileIdx, i, face);
+        }
+        return;
+    }
+
     // Calculate texture coordinates
     float tile_x = (float)(tileIdx % TILE_COUNT_X);
     float tile_y = floor(tileIdx / (float)TILE_COUNT_X);
-    
+
     float u0 = (tile_x * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
     float v0 = (tile_y * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
     float u1 = ((tile_x + 1) * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
     float v1 = ((tile_y + 1) * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
 
+    if (builder->indexed) {
+        add_vertex(builder, corners[0], u0, v0);
+        add_vertex(builder, corners[1], u1, v0);
+        add_vertex(builder, corners[2], u1, v1);
+        add_vertex(builder, corners[3], u0, v1);
+        return;
+    }
+
+    // Triangle 1
+    add_vertex(builder, corners[0], u0, v0);
+    add_vertex(builder, corners[1], u1, v0);
+    add_vertex(builder, corners[2], u1, v1);
+
+    // Triangle 2
+    add_vertex(builder, corners[0], u0, v0);
+    add_vertex(builder, corners[2], u1, v1);
+    add_vertex(builder, corners[3], u0, v1);
+}
+
+// Add a quad to the mesh
+void world_builder_add_quad(
+    WorldBuilder* builder,
+    vec3 start,
+    vec3 vec1,
+    vec3 vec2,
+    uint16_t tileIdx
+) {
     // Calculate quad corners
     vec3 corners[4] = {
         start,                                  // Corner 0
@@ -50,20 +145,17 @@ void world_builder_add_quad(
     };
 
     // Add two triangles (CCW winding)
-    // Triangle 1
-    add_vertex(builder, corners[0], u0, v0);
-    add_vertex(builder, corners[1], u1, v0);
-    add_vertex(builder, corners[2], u1, v1);
-    
-    // Triangle 2
-    add_vertex(builder, corners[0], u0, v0);
-    add_vertex(builder, corners[2], u1, v1);
-    add_vertex(builder, corners[3], u0, v1);
+    add_quad_corners(builder, corners, tileIdx, 0);
 }
 
 // Get the current vertex count
 size_t world_builder_get_vertex_count(const WorldBuilder* builder) {
-    return builder->current_index / VERTEX_STRIDE;
+    return builder->size / builder->stride;
+}
+
+size_t world_builder_get_element_count(const WorldBuilder* builder) {
+    size_t vertex_count = world_builder_get_vertex_count(builder);
+    return builder->indexed ? vertex_count / QUAD_VERTICES * QUAD_INDICES : vertex_count;
 }
 
 // Adds a cube to the mesh with the given center position, size, and tile indices for each face
@@ -117,38 +209,334 @@ void world_builder_add_cube(
         (vec3){size, 0, 0}, (vec3){0, 0, -size}, bottom_tile);
 }
 
-void world_builder_heightmap(WorldBuilder* builder, float width, float depth, float tileSize, Heightmap_Func heightmap_func) {
-    float half_width = width * 0.5f;
-    float half_depth = depth * 0.5f;
-    for (float x = 0; x < width; x+= tileSize) {
-        for (float z = 0; z < depth; z+= tileSize) {
-            float x1 = x * tileSize - half_width;
-            float z1 = z * tileSize - half_depth;
-            float x2 = x1 + tileSize;
-            float z2 = z1 + tileSize;
-
-            int tileIdx = heightmap_func(x1, z1) < 0.0f ? 5 : 11;
-            float tile_x = (float)(tileIdx % TILE_COUNT_X);
-            float tile_y = floor(tileIdx / (float)TILE_COUNT_X);
-            float u0 = (tile_x * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
-            float v0 = (tile_y * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
-            float u1 = ((tile_x + 1) * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
-            float v1 = ((tile_y + 1) * TILE_SIZE) / TEXTURE_ATLAS_SIZE;
-
-           vec3 coords[4] = {
-                { x1, heightmap_func(x1, z1), z1 },
-                { x2, heightmap_func(x2, z1), z1 },
-                { x2, heightmap_func(x2, z2), z2 },
-                { x1, heightmap_func(x1, z2), z2 }
-            };
-            add_vertex(builder, coords[0], u0, v0);
-            add_vertex(builder, coords[1], u1, v0);
-            add_vertex(builder, coords[2], u1, v1);
-
-            add_vertex(builder, coords[2], u1, v1);
-            add_vertex(builder, coords[3], u0, v1);
-            add_vertex(builder, coords[0], u0, v0);
+// Faces of a unit block in world_builder_add_cube order, with the neighbour that hides them
+static const struct {
+    int dx, dy, dz;
+    vec3 start, vec1, vec2;
+} voxel_faces[6] = {
+    {0, 0, 1, {0, 1, 1}, {1, 0, 0}, {0, -1, 0}},   // Front
+    {0, 0, -1, {1, 1, 0}, {-1, 0, 0}, {0, -1, 0}}, // Back
+    {-1, 0, 0, {0, 1, 0}, {0, 0, 1}, {0, -1, 0}},  // Left
+    {1, 0, 0, {1, 1, 1}, {0, 0, -1}, {0, -1, 0}},  // Right
+    {0, 1, 0, {0, 1, 0}, {1, 0, 0}, {0, 0, 1}},    // Top
+    {0, -1, 0, {0, 0, 1}, {1, 0, 0}, {0, 0, -1}},  // Bottom
+};
+
+static bool voxel_solid(const uint8_t* blocks, int size_x, int size_y, int size_z, int x, int y, int z) {
+    if (x < 0 || y < 0 || z < 0 || x >= size_x || y >= size_y || z >= size_z) {
+        return false;
+    }
+    return blocks[VOXEL_INDEX(size_x, size_z, x, y, z)] != VOXEL_AIR;
+}
+
+size_t world_builder_voxel_face_count(const uint8_t* blocks, int size_x, int size_y, int size_z) {
+    size_t count = 0;
+    for (int y = 0; y < size_y; y++) {
+        for (int z = 0; z < size_z; z++) {
+            for (int x = 0; x < size_x; x++) {
+                if (blocks[VOXEL_INDEX(size_x, size_z, x, y, z)] == VOXEL_AIR) {
+                    continue;
+                }
+                for (int face = 0; face < 6; face++) {
+                    int nx = x + voxel_faces[face].dx;
+                    int ny = y + voxel_faces[face].dy;
+                    int nz = z + voxel_faces[face].dz;
+                    count += !voxel_solid(blocks, size_x, size_y, size_z, nx, ny, nz);
+                }
+            }
         }
     }
+    return count;
+}
+
+void world_builder_voxels(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    int size_x,
+    int size_y,
+    int size_z,
+    vec3 origin,
+    float block_size
+) {
+    for (int y = 0; y < size_y; y++) {
+        for (int z = 0; z < size_z; z++) {
+            for (int x = 0; x < size_x; x++) {
+                uint8_t block = blocks[VOXEL_INDEX(size_x, size_z, x, y, z)];
+                if (block == VOXEL_AIR) {
+                    continue;
+                }
+                vec3 base = {origin.x + x * block_size, origin.y + y * block_size, origin.z + z * block_size};
+                for (int face = 0; face < 6; face++) {
+                    int nx = x + voxel_faces[face].dx;
+                    int ny = y + voxel_faces[face].dy;
+                    int nz = z + voxel_faces[face].dz;
+                    if (voxel_solid(blocks, size_x, size_y, size_z, nx, ny, nz)) {
+                        continue;
+                    }
+                    vec3 start = vec3_add(base, vec3_scale(voxel_faces[face].start, block_size));
+                    world_builder_add_quad(builder, start, vec3_scale(voxel_faces[face].vec1, block_size),
+                                           vec3_scale(voxel_faces[face].vec2, block_size), block - 1);
+                }
+            }
+        }
+    }
+}
+
+// Internal helper to add one face of the box spanning box_size blocks from block box_min
+static void add_voxel_box_face(
+    WorldBuilder* builder,
+    int face,
+    const int box_min[3],
+    const int box_size[3],
+    uint8_t block,
+    vec3 origin,
+    float block_size
+) {
+    vec3 start = voxel_faces[face].start;
+    vec3 vec1 = voxel_faces[face].vec1;
+    vec3 vec2 = voxel_faces[face].vec2;
+    vec3 size = {box_size[0] * block_size, box_size[1] * block_size, box_size[2] * block_size};
+    vec3 base = {
+        origin.x + box_min[0] * block_size + start.x * size.x,
+        origin.y + box_min[1] * block_size + start.y * size.y,
+        origin.z + box_min[2] * block_size + start.z * size.z,
+    };
+    vec1 = (vec3){vec1.x * size.x, vec1.y * size.y, vec1.z * size.z};
+    vec2 = (vec3){vec2.x * size.x, vec2.y * size.y, vec2.z * size.z};
+    vec3 corners[4] = {
+        base,
+        vec3_add(base, vec1),
+        vec3_add(vec3_add(base, vec1), vec2),
+        vec3_add(base, vec2),
+    };
+    add_quad_corners(builder, corners, block - 1, (uint16_t)(face + 1));
+}
+
+// Sweeps every slice of the grid along each face normal. Exposed faces of a slice go into
+// a 2D mask holding their block, then each run of equal blocks is grown along the first
+// axis and then the second as far as the whole row matches. Only blocks at least border
+// cells inside the grid are meshed, the border just hides their faces
+static void voxels_greedy(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    const int grid[3],
+    int border,
+    vec3 origin,
+    float block_size
+) {
+    uint8_t mask[VOXEL_GREEDY_MAX_SIZE * VOXEL_GREEDY_MAX_SIZE];
+    int size[3] = {grid[0] - 2 * border, grid[1] - 2 * border, grid[2] - 2 * border};
+    for (int face = 0; face < 6; face++) {
+        int dir[3] = {voxel_faces[face].dx, voxel_faces[face].dy, voxel_faces[face].dz};
+        int n = dir[0] ? 0 : dir[1] ? 1 : 2; // Normal axis
+        int a = n == 0 ? 1 : 0;               // Mask axes
+        int b = n == 2 ? 1 : 2;
+        for (int slice = 0; slice < size[n]; slice++) {
+            int p[3];
+            p[n] = slice + border;
+            for (int j = 0; j < size[b]; j++) {
+                for (int i = 0; i < size[a]; i++) {
+                    p[a] = i + border;
+                    p[b] = j + border;
+                    uint8_t block = blocks[VOXEL_INDEX(grid[0], grid[2], p[0], p[1], p[2])];
+                    bool hidden = voxel_solid(blocks, grid[0], grid[1], grid[2], p[0] + dir[0], p[1] + dir[1], p[2] + dir[2]);
+                    mask[j * size[a] + i] = hidden ? VOXEL_AIR : block;
+                }
+            }
+
+            for (int j = 0; j < size[b]; j++) {
+                for (int i = 0; i < size[a];) {
+                    uint8_t* row = mask + j * size[a];
+                    uint8_t block = row[i];
+                    if (block == VOXEL_AIR) {
+                        i++;
+                        continue;
+                    }
+                    int width = 1;
+                    while (i + width < size[a] && row[i + width] == block) {
+                        width++;
+                    }
+                    int height = 1;
+                    for (; j + height < size[b]; height++) {
+                        uint8_t* next = row + height * size[a];
+                        int k = 0;
+                        while (k < width && next[i + k] == block) {
+                            k++;
+                        }
+                        if (k < width) {
+                            break;
+                        }
+                    }
+                    for (int dj = 0; dj < height; dj++) {
+                        memset(row + dj * size[a] + i, VOXEL_AIR, width);
+                    }
+
+                    int box_min[3], box_size[3];
+                    box_min[n] = slice;
+                    box_size[n] = 1;
+                    box_size[a] = builder->packed ? width : 1;
+                    box_size[b] = builder->packed ? height : 1;
+                    for (int dj = 0; dj < height; dj += box_size[b]) {
+                        for (int di = 0; di < width; di += box_size[a]) {
+                            box_min[a] = i + di;
+                            box_min[b] = j + dj;
+                            add_voxel_box_face(builder, face, box_min, box_size, block, origin, block_size);
+                        }
+                    }
+                    i += width;
+                }
+            }
+        }
+    }
+}
+
+void world_builder_voxels_greedy(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    int size_x,
+    int size_y,
+    int size_z,
+    vec3 origin,
+    float block_size
+) {
+    if (size_x > VOXEL_GREEDY_MAX_SIZE || size_y > VOXEL_GREEDY_MAX_SIZE || size_z > VOXEL_GREEDY_MAX_SIZE) {
+        world_builder_voxels(builder, blocks, size_x, size_y, size_z, origin, block_size);
+        return;
+    }
+    voxels_greedy(builder, blocks, (int[3]){size_x, size_y, size_z}, 0, origin, block_size);
+}
+
+void world_builder_voxels_greedy_bordered(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    int size_x,
+    int size_y,
+    int size_z,
+    vec3 origin,
+    float block_size
+) {
+    if (size_x > VOXEL_GREEDY_MAX_SIZE || size_y > VOXEL_GREEDY_MAX_SIZE || size_z > VOXEL_GREEDY_MAX_SIZE) {
+        return;
+    }
+    voxels_greedy(builder, blocks, (int[3]){size_x + 2, size_y + 2, size_z + 2}, 1, origin, block_size);
+}
+
+static void sample_heightmap_row(
+    Heightmap_Func heightmap_func,
+    Heightmap_Row_Func row_func,
+    float x,
+    float z,
+    float step,
+    int count,
+    float* heights
+) {
+    if (row_func) {
+        row_func(x, z, step, count, heights);
+        return;
+    }
+    for (int i = 0; i < count; i++) {
+        heights[i] = heightmap_func(x + i * step, z);
+    }
+}
+
+// Vertical quad hanging depth below the edge from a to b, facing along cross(b - a, up)
+static void add_skirt(WorldBuilder* builder, vec3 a, vec3 b, float depth, uint16_t tileIdx) {
+    vec3 coords[4] = {
+        a,
+        b,
+        { b.x, b.y - depth, b.z },
+        { a.x, a.y - depth, a.z }
+    };
+    add_quad_corners(builder, coords, tileIdx, 0);
+}
+
+// Walk the grid in strips of up to HEIGHTMAP_ROW_TILES tiles, keeping the two vertex rows
+// around the current tile row. Each row is sampled once and reused by the tiles on both sides
+static void heightmap_grid(
+    WorldBuilder* builder,
+    float start_x,
+    float start_z,
+    int tiles_x,
+    int tiles_z,
+    float tileSize,
+    float skirt_depth,
+    Heightmap_Func heightmap_func,
+    Heightmap_Row_Func row_func
+) {
+    float rows[2][HEIGHTMAP_ROW_TILES + 1];
+    bool skirts = skirt_depth > 0.0f;
+
+    for (int strip = 0; strip < tiles_x; strip += HEIGHTMAP_ROW_TILES) {
+        int strip_tiles = tiles_x - strip < HEIGHTMAP_ROW_TILES ? tiles_x - strip : HEIGHTMAP_ROW_TILES;
+        float strip_x = start_x + strip * tileSize;
+        float* near_row = rows[0];
+        float* far_row = rows[1];
+        sample_heightmap_row(heightmap_func, row_func, strip_x, start_z, tileSize, strip_tiles + 1, near_row);
+
+        for (int tz = 0; tz < tiles_z; tz++) {
+            float z1 = start_z + tz * tileSize;
+            float z2 = start_z + (tz + 1) * tileSize;
+            sample_heightmap_row(heightmap_func, row_func, strip_x, z2, tileSize, strip_tiles + 1, far_row);
+
+            for (int tx = 0; tx < strip_tiles; tx++) {
+                float x1 = strip_x + tx * tileSize;
+                float x2 = strip_x + (tx + 1) * tileSize;
+                uint16_t tileIdx = near_row[tx] < 0.0f ? 5 : 11;
+                vec3 coords[4] = {
+                    { x1, near_row[tx], z1 },
+                    { x2, near_row[tx + 1], z1 },
+                    { x2, far_row[tx + 1], z2 },
+                    { x1, far_row[tx], z2 }
+                };
+                add_quad_corners(builder, coords, tileIdx, 0);
+
+                if (!skirts) {
+                    continue;
+                }
+                if (tz == 0) {
+                    add_skirt(builder, coords[1], coords[0], skirt_depth, tileIdx);
+                }
+                if (tz == tiles_z - 1) {
+                    add_skirt(builder, coords[3], coords[2], skirt_depth, tileIdx);
+                }
+                if (strip + tx == 0) {
+                    add_skirt(builder, coords[0], coords[3], skirt_depth, tileIdx);
+                }
+                if (strip + tx == tiles_x - 1) {
+                    add_skirt(builder, coords[2], coords[1], skirt_depth, tileIdx);
+                }
+            }
+
+            float* swap = near_row;
+            near_row = far_row;
+            far_row = swap;
+        }
+    }
+}
+
+void world_builder_heightmap(WorldBuilder* builder, float width, float depth, float tileSize, Heightmap_Func heightmap_func) {
+    int tiles_x = (int)ceilf(width / tileSize);
+    int tiles_z = (int)ceilf(depth / tileSize);
+    heightmap_grid(builder, -width * 0.5f, -depth * 0.5f, tiles_x, tiles_z, tileSize, 0.0f, heightmap_func, NULL);
+}
+
+void world_builder_heightmap_rows(WorldBuilder* builder, float width, float depth, float tileSize, Heightmap_Row_Func row_func) {
+    int tiles_x = (int)ceilf(width / tileSize);
+    int tiles_z = (int)ceilf(depth / tileSize);
+    heightmap_grid(builder, -width * 0.5f, -depth * 0.5f, tiles_x, tiles_z, tileSize, 0.0f, NULL, row_func);
+}
+
+void world_builder_heightmap_patch(
+    WorldBuilder* builder,
+    float x,
+    float z,
+    int tiles_x,
+    int tiles_z,
+    float tileSize,
+    float skirt_depth,
+    Heightmap_Func heightmap_func,
+    Heightmap_Row_Func row_func
+) {
+    heightmap_grid(builder, x, z, tiles_x, tiles_z, tileSize, skirt_depth, heightmap_func, row_func);
 }
 
@@ -1,5 +1,6 @@
 #ifndef WORLD_BUILDER_H
 #define WORLD_BUILDER_H
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include "cmath.h"
@@ -9,16 +10,54 @@
 #define TILE_COUNT_Y 16
 #define TILE_SIZE (TEXTURE_ATLAS_SIZE / TILE_COUNT_X)
 #define VERTEX_STRIDE 5  // x,y,z,u,v
+#define QUAD_VERTICES 4  // Vertices per quad in indexed mode
+#define QUAD_INDICES 6   // Indices per quad, two triangles
+#define MAX_QUADS_INDEX16 (65536 / QUAD_VERTICES) // Quads addressable with 16-bit indices
+
+#define PACKED_POSITION_SCALE 256.0f   // Quantization steps per world unit
+#define PACKED_TILE_MASK 0xff
+#define PACKED_CORNER_SHIFT 8
+#define PACKED_FACE_SHIFT 10
+
+// 8 byte vertex for atlas textured geometry, drawn with SG_VERTEXFORMAT_SHORT4.
+// Positions are fixed point offsets from the builder origin, so a mesh can span
+// +-128 units around it at the default PACKED_POSITION_SCALE, adding a vertex outside that
+// range asserts. The texture coordinate is rebuilt in the vertex shader from
+// the atlas tile in the low 8 bits of tile_corner and the quad corner (0-3) above it.
+// Greedy voxel quads also store their cube face + 1 from bit 10, the shader then
+// repeats the tile once per unit across the quad
+typedef struct {
+    int16_t x, y, z;
+    uint16_t tile_corner;
+} Packed_Vertex;
 
 typedef struct {
-    float* vertex_buffer;  // Pointer to interleaved vertex data [x,y,z,u,v,...]
-    size_t current_index;  // Current byte position (in floats)
-    size_t max_vertices;   // Maximum number of vertices
+    void* vertex_buffer;   // Interleaved float vertices [x,y,z,u,v,...] or Packed_Vertex
+    size_t size;           // Bytes written to vertex_buffer
+    size_t capacity;       // Bytes available in vertex_buffer
+    size_t stride;         // Bytes per vertex, VERTEX_STRIDE floats or sizeof(Packed_Vertex)
+    bool indexed;          // 4 vertices per quad, drawn with the world_builder_quad_indices pattern
+    bool packed;           // Vertices are Packed_Vertex relative to origin
+    vec3 origin;
+    float position_scale;  // Packed steps per world unit
 } WorldBuilder;
 
-void world_builder_init(WorldBuilder* builder, float* vertex_buffer, size_t max_vertices);
+// vertex_buffer needs room for max_vertices vertices of VERTEX_STRIDE floats
+void world_builder_init(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices);
+// Same as world_builder_init, but quads only store their 4 corners
+void world_builder_init_indexed(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices);
+// Indexed mesh of Packed_Vertex relative to origin, vertex_buffer needs room for
+// max_vertices of them
+void world_builder_init_packed(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices, vec3 origin);
+// Packed mesh with position_scale steps per unit instead of PACKED_POSITION_SCALE, trading
+// precision for range. Draw it with 1 / position_scale in the shader's origin_scale.w
+void world_builder_init_packed_scaled(WorldBuilder* builder, void* vertex_buffer, size_t max_vertices, vec3 origin, float position_scale);
 
-static void add_vertex(WorldBuilder* builder, vec3 pos, float u, float v);
+// Fill the index pattern shared by every indexed mesh, 6 indices per quad. It only depends on
+// the quad count, so one static index buffer serves any mesh with up to quad_count quads.
+// 16-bit indices only reach MAX_QUADS_INDEX16 quads, quad_count must not be larger
+void world_builder_quad_indices16(uint16_t* indices, size_t quad_count);
+void world_builder_quad_indices32(uint32_t* indices, size_t quad_count);
 
 void world_builder_add_quad(
     WorldBuilder* builder,
@@ -29,6 +68,8 @@ void world_builder_add_quad(
 );
 
 size_t world_builder_get_vertex_count(const WorldBuilder* builder);
+// Number of elements to draw: indices in indexed mode, vertices otherwise
+size_t world_builder_get_element_count(const WorldBuilder* builder);
 
 void world_builder_add_cube(
     WorldBuilder* builder,
@@ -42,8 +83,88 @@ void world_builder_add_cube(
     uint16_t bottom_tile
 );
 
+// Voxel grids store blocks x fastest, then z, then y. VOXEL_AIR cells are empty and any
+// other value b is a solid block textured with atlas tile b - 1 on every face
+#define VOXEL_AIR 0
+#define VOXEL_INDEX(size_x, size_z, x, y, z) ((((size_t)(y) * (size_z)) + (size_t)(z)) * (size_x) + (size_t)(x))
+
+// Number of block faces that touch air, cells outside the grid count as air.
+// Multiply by QUAD_VERTICES to size the vertex buffer for world_builder_voxels
+size_t world_builder_voxel_face_count(const uint8_t* blocks, int size_x, int size_y, int size_z);
+
+// Add only the block faces that touch air. Block (x, y, z) spans origin + (x, y, z) * block_size
+// to origin + (x + 1, y + 1, z + 1) * block_size
+void world_builder_voxels(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    int size_x,
+    int size_y,
+    int size_z,
+    vec3 origin,
+    float block_size
+);
+
+#define VOXEL_GREEDY_MAX_SIZE 64 // Largest grid side world_builder_voxels_greedy merges
+
+// Same faces as world_builder_voxels, but coplanar neighbours with the same block are
+// merged into larger quads. Only packed builders can repeat a tile across a merged quad,
+// other builders get the merged quads split back into one quad per block face. Grids
+// with a side above VOXEL_GREEDY_MAX_SIZE fall back to world_builder_voxels
+void world_builder_voxels_greedy(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    int size_x,
+    int size_y,
+    int size_z,
+    vec3 origin,
+    float block_size
+);
+
+// Greedy mesh a size_x * size_y * size_z block region stored with a one block border on
+// every side, so blocks is (size_x + 2) * (size_y + 2) * (size_z + 2). Border blocks are only
+// used to hide faces, which lets neighbouring chunks mesh without faces between them.
+// origin is the corner of the first block inside the border
+void world_builder_voxels_greedy_bordered(
+    WorldBuilder* builder,
+    const uint8_t* blocks,
+    int size_x,
+    int size_y,
+    int size_z,
+    vec3 origin,
+    float block_size
+);
+
 typedef float (*Heightmap_Func)(float x, float z);
+// Fill heights[i] with the height at (x + i * step, z) for every i below count
+typedef void (*Heightmap_Row_Func)(float x, float z, float step, int count, float* heights);
 
+#define HEIGHTMAP_ROW_TILES 256 // Tiles per row strip, wider grids are meshed in several strips
+
+// Terrain of width * depth centered on the origin with one quad per tileSize square, textured
+// by whether the first corner of the tile is below zero. Heights are sampled once per grid
+// vertex into a row buffer and shared by the tiles around it
 void world_builder_heightmap(WorldBuilder* builder, float width, float depth, float tileSize, Heightmap_Func heightmap_func);
+// Same terrain, but row_func fills a whole row of heights per call, so it can batch the math.
+// Rows hold at most HEIGHTMAP_ROW_TILES + 1 heights
+void world_builder_heightmap_rows(WorldBuilder* builder, float width, float depth, float tileSize, Heightmap_Row_Func row_func);
+
+// Number of quads world_builder_heightmap_patch adds, including skirts
+#define HEIGHTMAP_PATCH_QUADS(tiles_x, tiles_z, skirts) ((tiles_x) * (tiles_z) + ((skirts) ? 2 * ((tiles_x) + (tiles_z)) : 0))
+
+// tiles_x * tiles_z tiles with the first corner at (x, z). With a skirt_depth above zero every
+// border edge also gets a quad hanging skirt_depth below it, facing out of the patch, which
+// hides the cracks against a neighbouring patch with other tile sizes. Heights come from
+// row_func, or heightmap_func when row_func is NULL
+void world_builder_heightmap_patch(
+    WorldBuilder* builder,
+    float x,
+    float z,
+    int tiles_x,
+    int tiles_z,
+    float tileSize,
+    float skirt_depth,
+    Heightmap_Func heightmap_func,
+    Heightmap_Row_Func row_func
+);
 
 #endif // WORLD_BUILDER_H
@@ -1,20 +1,281 @@
 #include "arena.h"
+#include "cmath.h"
+#include "hash_map.h"
+#include "pool.h"
+#include "slot_map.h"
+#include "strings.h"
+#include "../ex03-cubes/world_builder.h"
+#include <math.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 void do_something() {
     Cab_Arena *arena = cab_arena_create(2048);
     cab_arena_alloc(arena, 128);
     char *buf = cab_arena_alloc(arena, 512);
-    sprintf(buf, "Allocated %d bytes in the arena.\n", arena->size);
+    sprintf(buf, "Allocated %zu bytes in the arena.\n", arena->size);
     printf("%s", buf);
-    printf("Arena size: %d\n", arena->capacity);
+    printf("Arena size: %zu\n", arena->capacity);
     cab_arena_destroy(arena);
 }
 
+void do_something_growable() {
+    Cab_Arena *arena = cab_arena_create_growable(1024);
+    for (int i = 0; i < 8; i++) {
+        cab_arena_alloc(arena, 300);
+    }
+    double *values = cab_arena_alloc_aligned(arena, 16 * sizeof(double), 64);
+    printf("Growable arena: %zu bytes used, %zu bytes owned, 64-byte aligned: %s\n",
+           arena->size, arena->capacity, ((size_t)values % 64) == 0 ? "yes" : "no");
+    Cab_Arena_Mark mark = cab_arena_mark(arena);
+    for (int i = 0; i < 8; i++) {
+        cab_arena_alloc(arena, 300);
+    }
+    cab_arena_rewind(arena, mark);
+    printf("After rewind: %zu bytes used, %zu bytes owned\n", arena->size, arena->capacity);
+    cab_arena_reset(arena);
+    printf("After reset: %zu bytes used, %zu bytes owned\n", arena->size, arena->capacity);
+    cab_arena_release(arena);
+    printf("After release: %zu bytes used, %zu bytes owned\n", arena->size, arena->capacity);
+    cab_arena_destroy(arena);
+}
+
+typedef struct Particle {
+    float x, y, z;
+    float vx, vy, vz;
+    float life;
+} Particle;
+
+void do_something_pooled() {
+    Cab_Pool *pool = cab_pool_create(sizeof(Particle), CAB_CACHE_LINE_SIZE, 64);
+    Particle *live[200];
+    for (int i = 0; i < 200; i++) {
+        live[i] = cab_pool_alloc(pool);
+    }
+    for (int i = 0; i < 200; i += 2) {
+        cab_pool_free(pool, live[i]);
+    }
+    for (int i = 0; i < 50; i++) {
+        cab_pool_alloc(pool);
+    }
+    printf("Pool: %zu of %zu slots in use, high water %zu, %zu bytes per slot\n",
+           pool->count, pool->capacity, pool->high_water, pool->slot_size);
+    cab_pool_destroy(pool);
+}
+
+void do_something_slot_mapped() {
+    Cab_Slot_Map *particles = cab_slot_map_create(sizeof(Particle), 1000);
+    Cab_Handle handles[100];
+    for (int i = 0; i < 100; i++) {
+        handles[i] = cab_slot_map_insert(particles, &(Particle){.life = (float)i});
+    }
+    for (int i = 0; i < 100; i += 3) {
+        cab_slot_map_remove(particles, handles[i]);
+    }
+    float total_life = 0.0f;
+    Particle *items = particles->items;
+    for (uint32_t i = 0; i < particles->count; i++) {
+        total_life += items[i].life;
+    }
+    printf("Slot map: %u live particles, total life %.0f, stale handle resolves: %s\n",
+           particles->count, total_life, cab_slot_map_get(particles, handles[0]) ? "yes" : "no");
+    cab_slot_map_destroy(particles);
+}
+
+CAB_HASH_MAP_SV(Asset_Map, asset_map, int)
+
+void do_something_hashed() {
+    Asset_Map assets = asset_map_create(0);
+    asset_map_put(assets, CAB_SV("neo16.png"), 1);
+    asset_map_put(assets, CAB_SV("baboon.png"), 2);
+    asset_map_put(assets, CAB_SV("vincent.png"), 3);
+    asset_map_remove(assets, CAB_SV("baboon.png"));
+    int *id = asset_map_get(assets, CAB_SV("vincent.png"));
+    printf("Hash map: %zu assets, vincent.png has id %d, baboon.png found: %s\n",
+           assets.map->count, id ? *id : -1, asset_map_get(assets, CAB_SV("baboon.png")) ? "yes" : "no");
+    asset_map_destroy(assets);
+}
+
+void do_something_interned() {
+    Cab_Intern_Table *names = cab_intern_create(0);
+    Cab_String_Id jump = cab_intern(names, CAB_SV("player.jump"));
+    Cab_String_Id land = cab_intern(names, CAB_SV("player.land"));
+
+    Cab_Arena *scratch = cab_arena_create_growable(0);
+    Cab_String_Builder sb = cab_sb_create(scratch, 0);
+    cab_sb_append_cstr(&sb, "player.");
+    cab_sb_append_cstr(&sb, "jump");
+    Cab_String_Id event = cab_intern_find(names, cab_sb_to_sv(&sb));
+    printf("Interning: %s has id %u, matches jump: %s, matches land: %s\n",
+           sb.data, event, event == jump ? "yes" : "no", event == land ? "yes" : "no");
+    cab_arena_destroy(scratch);
+    cab_intern_destroy(names);
+}
+
+// Gauss-Jordan with partial pivoting in double, the reference for the float inverses
+static bool invert_reference(double out[4][4], const mat4 *m) {
+    double a[4][8];
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            a[row][col] = m->elements[col][row];
+            a[row][col + 4] = row == col ? 1.0 : 0.0;
+        }
+    }
+    for (int col = 0; col < 4; col++) {
+        int pivot = col;
+        for (int row = col + 1; row < 4; row++) {
+            if (fabs(a[row][col]) > fabs(a[pivot][col])) {
+                pivot = row;
+            }
+        }
+        if (a[pivot][col] == 0.0) {
+            return false;
+        }
+        for (int k = 0; k < 8; k++) {
+            double t = a[col][k];
+            a[col][k] = a[pivot][k];
+            a[pivot][k] = t;
+        }
+        double inv = 1.0 / a[col][col];
+        for (int k = 0; k < 8; k++) {
+            a[col][k] *= inv;
+        }
+        for (int row = 0; row < 4; row++) {
+            if (row != col) {
+                double f = a[row][col];
+                for (int k = 0; k < 8; k++) {
+                    a[row][k] -= f * a[col][k];
+                }
+            }
+        }
+    }
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            out[col][row] = a[row][col + 4];
+        }
+    }
+    return true;
+}
+
+// Largest difference to the reference, relative to its largest element
+static double relative_error(const mat4 *m, double ref[4][4]) {
+    double diff = 0.0;
+    double scale = 0.0;
+    for (int col = 0; col < 4; col++) {
+        for (int row = 0; row < 4; row++) {
+            diff = fmax(diff, fabs(m->elements[col][row] - ref[col][row]));
+            scale = fmax(scale, fabs(ref[col][row]));
+        }
+    }
+    return diff / scale;
+}
+
+static float random_range(float lo, float hi) {
+    return lo + (hi - lo) * (float)rand() / (float)RAND_MAX;
+}
+
+// Returns false when any inverse is further from the reference than its tolerance
+bool do_something_inverted() {
+    srand(15);
+    double general_error = 0.0;
+    double affine_error = 0.0;
+    double normal_error = 0.0;
+    for (int i = 0; i < 1000; i++) {
+        // Model matrices: rotation, non-uniform scale and translation
+        mat4 scale = mat4_create();
+        scale.elements[0][0] = random_range(0.25f, 4.0f);
+        scale.elements[1][1] = random_range(0.25f, 4.0f);
+        scale.elements[2][2] = random_range(0.25f, 4.0f);
+        mat4 model = mat4_multiply(mat4_rotate_y(mat4_rotation_x(random_range(-3.0f, 3.0f)), random_range(-3.0f, 3.0f)), scale);
+        model.elements[3][0] = random_range(-100.0f, 100.0f);
+        model.elements[3][1] = random_range(-100.0f, 100.0f);
+        model.elements[3][2] = random_range(-100.0f, 100.0f);
+
+        // View-projection matrices for the general inverse
+        vec3 eye = {random_range(-50.0f, 50.0f), random_range(1.0f, 50.0f), random_range(-50.0f, 50.0f)};
+        mat4 view_proj = mat4_multiply(mat4_perspective(random_range(0.5f, 1.5f), random_range(0.5f, 2.0f), 0.1f, 1000.0f),
+                                       mat4_look_at(eye, (vec3){0.0f, 0.0f, 0.0f}, (vec3){0.0f, 1.0f, 0.0f}));
+
+        double ref[4][4];
+        mat4 result;
+        if (invert_reference(ref, &view_proj) && mat4_to_inverse(&result, &view_proj)) {
+            general_error = fmax(general_error, relative_error(&result, ref));
+        }
+        if (invert_reference(ref, &model) && mat4_to_inverse_affine(&result, &model)) {
+            affine_error = fmax(affine_error, relative_error(&result, ref));
+
+            // The normal matrix is the transposed upper 3x3 of the inverse
+            double normal[4][4] = {{0.0}};
+            for (int col = 0; col < 3; col++) {
+                for (int row = 0; row < 3; row++) {
+                    normal[col][row] = ref[row][col];
+                }
+            }
+            normal[3][3] = 1.0;
+            mat4_to_normal_matrix(&result, &model);
+            normal_error = fmax(normal_error, relative_error(&result, normal));
+        }
+    }
+    // Projections with a far / near ratio of 10000 lose a few more bits than model matrices
+    bool ok = general_error < 1e-4 && affine_error < 1e-6 && normal_error < 1e-6;
+    printf("Inverse vs double: general %.1e, affine %.1e, normal matrix %.1e, within tolerance: %s\n",
+           general_error, affine_error, normal_error, ok ? "yes" : "no");
+    return ok;
+}
+
+// Exposed faces of a size^3 grid, meshed into a buffer sized from the count
+static size_t count_voxel_faces(const uint8_t *blocks, int size_x, int size_y, int size_z, size_t *meshed) {
+    static Packed_Vertex vertices[6 * 4 * 4 * 4 * QUAD_VERTICES];
+    size_t faces = world_builder_voxel_face_count(blocks, size_x, size_y, size_z);
+    WorldBuilder builder;
+    world_builder_init_packed(&builder, vertices, faces * QUAD_VERTICES, (vec3){0.0f, 0.0f, 0.0f});
+    world_builder_voxels(&builder, blocks, size_x, size_y, size_z, (vec3){0.0f, 0.0f, 0.0f}, 1.0f);
+    *meshed = world_builder_get_vertex_count(&builder) / QUAD_VERTICES;
+    return faces;
+}
+
+// Returns false when a face count is wrong or does not match the mesh
+bool do_something_voxel_counted() {
+    uint8_t single[1] = {1};
+    uint8_t pair[2] = {1, 1};
+    uint8_t solid[4 * 4 * 4];
+    uint8_t hollow[4 * 4 * 4];
+    memset(solid, 1, sizeof(solid));
+    memset(hollow, 1, sizeof(hollow));
+    hollow[VOXEL_INDEX(4, 4, 1, 1, 1)] = VOXEL_AIR;
+
+    size_t meshed[4];
+    size_t faces[4] = {
+        count_voxel_faces(single, 1, 1, 1, &meshed[0]),
+        count_voxel_faces(solid, 4, 4, 4, &meshed[1]),
+        count_voxel_faces(pair, 2, 1, 1, &meshed[2]),
+        count_voxel_faces(hollow, 4, 4, 4, &meshed[3]),
+    };
+    size_t expected[4] = {6, 96, 10, 102};
+    bool ok = true;
+    for (int i = 0; i < 4; i++) {
+        ok = ok && faces[i] == expected[i] && meshed[i] == faces[i];
+    }
+    printf("Voxel faces: single %zu, solid 4^3 %zu, adjacent pair %zu, 4^3 with a hole %zu, meshed the same: %s\n",
+           faces[0], faces[1], faces[2], faces[3], ok ? "yes" : "no");
+    return ok;
+}
+
 int main(int argc, char *argv[]) {
     printf("Hello again, World!\n");
     for (int i = 0; i < 2; i++) {
         do_something();
     }
-    return 0;
+    do_something_growable();
+    do_something_pooled();
+    do_something_slot_mapped();
+    do_something_hashed();
+    do_something_interned();
+    bool ok = do_something_inverted();
+    ok = do_something_voxel_counted() && ok;
+
+    cab_mem_write_csv_header(stdout);
+    cab_mem_write_csv(stdout, 0);
+    return ok ? 0 : 1;
 }
@@ -1,31 +1,350 @@
+#if !defined(_WIN32)
+#define _DEFAULT_SOURCE // MAP_ANONYMOUS and madvise are hidden by strict -std modes
+#endif
+
 #include "arena.h"
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 
-Cab_Arena *cab_arena_create(int initial_capacity) {
-    Cab_Arena *arena = (Cab_Arena *)malloc(sizeof(Cab_Arena) + initial_capacity);
-    if (!arena) {
-        return NULL;
-    }
+#if defined(_WIN32)
+#include <windows.h>
+#elif !defined(__wasm__)
+#include <sys/mman.h>
+#endif
+
+#define CAB_ALIGN_UP(value, alignment) (((value) + ((alignment) - 1)) & ~((size_t)(alignment) - 1))
+
+// Headers are padded so that block data always starts on a CAB_ARENA_DEFAULT_ALIGNMENT boundary
+#define ARENA_HEADER_SIZE CAB_ALIGN_UP(sizeof(Cab_Arena), CAB_ARENA_DEFAULT_ALIGNMENT)
+#define BLOCK_HEADER_SIZE CAB_ALIGN_UP(sizeof(Cab_Arena_Block), CAB_ARENA_DEFAULT_ALIGNMENT)
+
+static inline char *block_data(Cab_Arena_Block *block) {
+    return (char *)block + BLOCK_HEADER_SIZE;
+}
+
+// The first block lives in the same allocation as the arena itself
+static inline Cab_Arena_Block *first_block(Cab_Arena *arena) {
+    return (Cab_Arena_Block *)((char *)arena + ARENA_HEADER_SIZE);
+}
+
+// --- Virtual memory ---
+// Reserve address space without backing it, then commit and decommit ranges of it.
+// wasm has no way to reserve, and growing linear memory behind malloc's back would hand the
+// same pages to both, so virtual arenas are growable arenas there and never reach these.
+
+#if defined(_WIN32)
+
+static void *os_reserve(size_t size) {
+    return VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+}
+
+static bool os_commit(void *ptr, size_t size) {
+    return VirtualAlloc(ptr, size, MEM_COMMIT, PAGE_READWRITE) != NULL;
+}
+
+static bool os_decommit(void *ptr, size_t size) {
+    return VirtualFree(ptr, size, MEM_DECOMMIT) != 0;
+}
+
+static void os_release(void *ptr, size_t size) {
+    (void)size;
+    VirtualFree(ptr, 0, MEM_RELEASE);
+}
+
+#elif defined(__wasm__)
+
+static bool os_commit(void *ptr, size_t size) {
+    (void)ptr;
+    (void)size;
+    return false;
+}
+
+static bool os_decommit(void *ptr, size_t size) {
+    (void)ptr;
+    (void)size;
+    return false;
+}
+
+static void os_release(void *ptr, size_t size) {
+    (void)ptr;
+    (void)size;
+}
+
+#else
+
+static void *os_reserve(size_t size) {
+    void *ptr = mmap(NULL, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+static bool os_commit(void *ptr, size_t size) {
+    return mprotect(ptr, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+static bool os_decommit(void *ptr, size_t size) {
+    madvise(ptr, size, MADV_DONTNEED);
+    return mprotect(ptr, size, PROT_NONE) == 0;
+}
+
+static void os_release(void *ptr, size_t size) {
+    munmap(ptr, size);
+}
+
+#endif
+
+// --- Arena ---
+
+static Cab_Arena *arena_init(void *memory, size_t initial_capacity, size_t block_size, int flags, Cab_Mem_Tag tag) {
+    Cab_Arena *arena = (Cab_Arena *)memory;
+    Cab_Arena_Block *block = first_block(arena);
+    block->prev = NULL;
+    block->size = 0;
+    block->capacity = initial_capacity;
+
     arena->size = 0;
     arena->capacity = initial_capacity;
-    arena->data = ((char *)arena + sizeof(Cab_Arena));
+    arena->block_size = block_size;
+    arena->committed = initial_capacity;
+    arena->flags = flags;
+    arena->tag = tag;
+    arena->current = block;
+    arena->free_blocks = NULL;
     return arena;
 }
 
+static Cab_Arena *arena_create(size_t initial_capacity, size_t block_size, int flags, Cab_Mem_Tag tag) {
+    if (initial_capacity > SIZE_MAX - ARENA_HEADER_SIZE - BLOCK_HEADER_SIZE) {
+        return NULL;
+    }
+    void *memory = malloc(ARENA_HEADER_SIZE + BLOCK_HEADER_SIZE + initial_capacity);
+    if (!memory) {
+        return NULL;
+    }
+    cab_mem_track_alloc(tag, initial_capacity);
+    return arena_init(memory, initial_capacity, block_size, flags, tag);
+}
+
+Cab_Arena *cab_arena_create(size_t initial_capacity) {
+    return cab_arena_create_tagged(initial_capacity, CAB_MEM_TAG_UNTAGGED);
+}
+
+Cab_Arena *cab_arena_create_growable(size_t block_size) {
+    return cab_arena_create_growable_tagged(block_size, CAB_MEM_TAG_UNTAGGED);
+}
+
+Cab_Arena *cab_arena_create_virtual(size_t reserve_size) {
+    return cab_arena_create_virtual_tagged(reserve_size, CAB_MEM_TAG_UNTAGGED);
+}
+
+Cab_Arena *cab_arena_create_tagged(size_t initial_capacity, Cab_Mem_Tag tag) {
+    return arena_create(initial_capacity, initial_capacity, CAB_ARENA_FIXED, tag);
+}
+
+Cab_Arena *cab_arena_create_growable_tagged(size_t block_size, Cab_Mem_Tag tag) {
+    if (block_size == 0) {
+        block_size = CAB_ARENA_DEFAULT_BLOCK_SIZE;
+    }
+    return arena_create(block_size, block_size, CAB_ARENA_GROWABLE, tag);
+}
+
+Cab_Arena *cab_arena_create_virtual_tagged(size_t reserve_size, Cab_Mem_Tag tag) {
+#if defined(__wasm__)
+    // Chained malloc blocks keep pointers stable too, and malloc stays the only owner of memory.grow
+    (void)reserve_size;
+    return cab_arena_create_growable_tagged(CAB_ARENA_COMMIT_SIZE, tag);
+#else
+    if (reserve_size > SIZE_MAX - CAB_ARENA_COMMIT_SIZE) {
+        return NULL;
+    }
+    reserve_size = CAB_ALIGN_UP(reserve_size, CAB_ARENA_COMMIT_SIZE);
+    if (reserve_size == 0) {
+        return NULL;
+    }
+    void *memory = os_reserve(reserve_size);
+    if (!memory) {
+        return NULL;
+    }
+    if (!os_commit(memory, CAB_ARENA_COMMIT_SIZE)) {
+        os_release(memory, reserve_size);
+        return NULL;
+    }
+    Cab_Arena *arena = arena_init(memory, reserve_size - ARENA_HEADER_SIZE - BLOCK_HEADER_SIZE, 0, CAB_ARENA_VIRTUAL, tag);
+    arena->committed = CAB_ARENA_COMMIT_SIZE - ARENA_HEADER_SIZE - BLOCK_HEADER_SIZE;
+    cab_mem_track_alloc(tag, arena->committed);
+    return arena;
+#endif
+}
+
+// Commit pages so that the first end bytes of the first block are usable
+static bool virtual_commit(Cab_Arena *arena, size_t end) {
+    size_t header = ARENA_HEADER_SIZE + BLOCK_HEADER_SIZE;
+    size_t committed = header + arena->committed;
+    size_t target = CAB_ALIGN_UP(header + end, CAB_ARENA_COMMIT_SIZE);
+    if (!os_commit((char *)arena + committed, target - committed)) {
+        return false;
+    }
+    cab_mem_track_resize(arena->tag, arena->committed, target - header);
+    arena->committed = target - header;
+    return true;
+}
+
+static void virtual_decommit(Cab_Arena *arena) {
+    size_t header = ARENA_HEADER_SIZE + BLOCK_HEADER_SIZE;
+    size_t committed = header + arena->committed;
+    // Pages that could not be decommitted stay committed and are reused as they are
+    if (committed > CAB_ARENA_COMMIT_SIZE && os_decommit((char *)arena + CAB_ARENA_COMMIT_SIZE, committed - CAB_ARENA_COMMIT_SIZE)) {
+        cab_mem_track_resize(arena->tag, arena->committed, CAB_ARENA_COMMIT_SIZE - header);
+        arena->committed = CAB_ARENA_COMMIT_SIZE - header;
+    }
+}
+
+static void free_block_list(Cab_Arena *arena, Cab_Arena_Block *block) {
+    Cab_Arena_Block *first = first_block(arena);
+    while (block) {
+        Cab_Arena_Block *prev = block->prev;
+        if (block != first) {
+            arena->capacity -= block->capacity;
+            cab_mem_track_free(arena->tag, block->capacity);
+            free(block);
+        }
+        block = prev;
+    }
+}
+
 void cab_arena_destroy(Cab_Arena *arena) {
+    if (!arena) {
+        return;
+    }
+    if (arena->flags & CAB_ARENA_VIRTUAL) {
+        cab_mem_track_free(arena->tag, arena->committed);
+        os_release(arena, ARENA_HEADER_SIZE + BLOCK_HEADER_SIZE + first_block(arena)->capacity);
+        return;
+    }
+    free_block_list(arena, arena->current);
+    free_block_list(arena, arena->free_blocks);
+    cab_mem_track_free(arena->tag, first_block(arena)->capacity);
     free(arena);
 }
 
-void *cab_arena_alloc(Cab_Arena *arena, int size) {
-    if (arena->size + size > arena->capacity) {
+static void retag_block_list(Cab_Arena *arena, Cab_Arena_Block *block, Cab_Mem_Tag tag) {
+    for (; block; block = block->prev) {
+        cab_mem_track_retag(arena->tag, tag, block->capacity);
+    }
+}
+
+void cab_arena_set_tag(Cab_Arena *arena, Cab_Mem_Tag tag) {
+    if (arena->flags & CAB_ARENA_VIRTUAL) {
+        cab_mem_track_retag(arena->tag, tag, arena->committed);
+    } else {
+        retag_block_list(arena, arena->current, tag);
+        retag_block_list(arena, arena->free_blocks, tag);
+    }
+    arena->tag = tag;
+}
+
+// Find a block with room for size bytes, preferring blocks kept by a previous reset
+static Cab_Arena_Block *acquire_block(Cab_Arena *arena, size_t size) {
+    Cab_Arena_Block **link = &arena->free_blocks;
+    while (*link) {
+        Cab_Arena_Block *block = *link;
+        if (block->capacity >= size) {
+            *link = block->prev;
+            block->size = 0;
+            return block;
+        }
+        link = &block->prev;
+    }
+
+    size_t capacity = size > arena->block_size ? size : arena->block_size;
+    if (capacity > SIZE_MAX - BLOCK_HEADER_SIZE) {
+        return NULL;
+    }
+    Cab_Arena_Block *block = (Cab_Arena_Block *)malloc(BLOCK_HEADER_SIZE + capacity);
+    if (!block) {
         return NULL;
     }
-    void *ptr = (char *)arena->data + arena->size;
-    arena->size += size;
-    return ptr;
+    block->size = 0;
+    block->capacity = capacity;
+    arena->capacity += capacity;
+    cab_mem_track_alloc(arena->tag, capacity);
+    return block;
+}
+
+void *cab_arena_alloc_aligned(Cab_Arena *arena, size_t size, size_t alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        return NULL;
+    }
+
+    Cab_Arena_Block *block = arena->current;
+    uintptr_t base = (uintptr_t)block_data(block);
+    uintptr_t offset = CAB_ALIGN_UP(base + block->size, alignment) - base;
+    if (offset > block->capacity || size > block->capacity - offset) {
+        if (!(arena->flags & CAB_ARENA_GROWABLE)) {
+            return NULL;
+        }
+        // Block data is already aligned to CAB_ARENA_DEFAULT_ALIGNMENT, only stricter alignments need padding
+        size_t padding = alignment > CAB_ARENA_DEFAULT_ALIGNMENT ? alignment - CAB_ARENA_DEFAULT_ALIGNMENT : 0;
+        if (size > SIZE_MAX - padding) {
+            return NULL;
+        }
+        Cab_Arena_Block *next = acquire_block(arena, size + padding);
+        if (!next) {
+            return NULL;
+        }
+        next->prev = block;
+        arena->current = next;
+        block = next;
+        base = (uintptr_t)block_data(block);
+        offset = CAB_ALIGN_UP(base, alignment) - base;
+    }
+    if ((arena->flags & CAB_ARENA_VIRTUAL) && offset + size > arena->committed) {
+        if (!virtual_commit(arena, offset + size)) {
+            return NULL;
+        }
+    }
+
+    arena->size += offset + size - block->size;
+    block->size = offset + size;
+    return (char *)base + offset;
+}
+
+void *cab_arena_alloc(Cab_Arena *arena, size_t size) {
+    return cab_arena_alloc_aligned(arena, size, CAB_ARENA_DEFAULT_ALIGNMENT);
+}
+
+Cab_Arena_Mark cab_arena_mark(Cab_Arena *arena) {
+    return (Cab_Arena_Mark){
+        .block = arena->current,
+        .block_size = arena->current->size,
+        .size = arena->size,
+    };
+}
+
+void cab_arena_rewind(Cab_Arena *arena, Cab_Arena_Mark mark) {
+    Cab_Arena_Block *block = arena->current;
+    while (block != mark.block) {
+        Cab_Arena_Block *prev = block->prev;
+        block->prev = arena->free_blocks;
+        arena->free_blocks = block;
+        block = prev;
+    }
+    block->size = mark.block_size;
+    arena->current = block;
+    arena->size = mark.size;
 }
 
 void cab_arena_reset(Cab_Arena *arena) {
-    arena->size = 0;
+    cab_arena_rewind(arena, (Cab_Arena_Mark){.block = first_block(arena)});
+}
+
+void cab_arena_release(Cab_Arena *arena) {
+    cab_arena_reset(arena);
+    if (arena->flags & CAB_ARENA_VIRTUAL) {
+        virtual_decommit(arena);
+        return;
+    }
+    free_block_list(arena, arena->free_blocks);
+    arena->free_blocks = NULL;
 }
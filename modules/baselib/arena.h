@@ -1,18 +1,80 @@
 #ifndef CAB_ARENA_H
 #define CAB_ARENA_H
 
+#include <stddef.h>
+#include "mem_track.h"
+
+#define CAB_ARENA_DEFAULT_ALIGNMENT 16
+#define CAB_ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+// wasm builds without threads have no atomics or thread-local storage
+#if defined(__wasm__) && !defined(__wasm_atomics__)
+#define CAB_SINGLE_THREADED
+#endif
+
+#define CAB_CACHE_LINE_SIZE 64
+#define CAB_ARENA_COMMIT_SIZE (64 * 1024) // Granularity of virtual arena commits, one wasm page
+
+typedef enum Cab_Arena_Flags {
+    CAB_ARENA_FIXED = 0,         // Single block, allocations fail once it is full
+    CAB_ARENA_GROWABLE = 1 << 0, // Chain a new block whenever the current one is full
+    CAB_ARENA_VIRTUAL = 1 << 1,  // Single reserved address range, pages are committed as the arena advances
+} Cab_Arena_Flags;
+
+typedef struct Cab_Arena_Block {
+    struct Cab_Arena_Block *prev; // Previous block in the chain (next block when on the free list)
+    size_t size;                  // Bytes used in this block
+    size_t capacity;              // Usable bytes in this block
+} Cab_Arena_Block;
+
 typedef struct Cab_Arena {
-    int size;
-    int capacity;
-    void *data;
+    size_t size;                  // Bytes used across all blocks, including alignment padding
+    size_t capacity;              // Bytes owned across all blocks, including blocks kept for reuse
+    size_t block_size;            // Minimum capacity of chained blocks
+    size_t committed;             // Bytes of the first block backed by memory (virtual arenas only)
+    int flags;                    // Cab_Arena_Flags
+    Cab_Mem_Tag tag;              // Subsystem the arena's memory is charged to
+    Cab_Arena_Block *current;     // Block that allocations are served from
+    Cab_Arena_Block *free_blocks; // Chained blocks kept for reuse after a reset
 } Cab_Arena;
 
-Cab_Arena *cab_arena_create(int initial_capacity);
+// Saved arena position, see cab_arena_mark/cab_arena_rewind
+typedef struct Cab_Arena_Mark {
+    Cab_Arena_Block *block;
+    size_t block_size;
+    size_t size;
+} Cab_Arena_Mark;
+
+// Create an arena with a single block that never grows
+Cab_Arena *cab_arena_create(size_t initial_capacity);
+// Create an arena that chains blocks of at least block_size bytes on demand
+Cab_Arena *cab_arena_create_growable(size_t block_size);
+// Create an arena that reserves reserve_size bytes of address space up front and commits pages on demand.
+// Pointers stay stable and growth never copies. wasm cannot reserve address space, so there it
+// is a growable arena of CAB_ARENA_COMMIT_SIZE blocks and allocations are not contiguous
+Cab_Arena *cab_arena_create_virtual(size_t reserve_size);
+// Same as the create functions above, with the arena's memory charged to tag from the start
+Cab_Arena *cab_arena_create_tagged(size_t initial_capacity, Cab_Mem_Tag tag);
+Cab_Arena *cab_arena_create_growable_tagged(size_t block_size, Cab_Mem_Tag tag);
+Cab_Arena *cab_arena_create_virtual_tagged(size_t reserve_size, Cab_Mem_Tag tag);
 void cab_arena_destroy(Cab_Arena *arena);
 
-void *cab_arena_alloc(Cab_Arena *arena, int size);
-void cab_arena_reset(Cab_Arena *arena);
+// Charge the arena's memory to tag from now on. Arenas from the untagged create functions start
+// out as CAB_MEM_TAG_UNTAGGED
+void cab_arena_set_tag(Cab_Arena *arena, Cab_Mem_Tag tag);
 
-#endif // CAB_ARENA_H
+// Allocate size bytes aligned to CAB_ARENA_DEFAULT_ALIGNMENT
+void *cab_arena_alloc(Cab_Arena *arena, size_t size);
+// Allocate size bytes aligned to alignment, which must be a power of two
+void *cab_arena_alloc_aligned(Cab_Arena *arena, size_t size, size_t alignment);
 
+// Empty the arena, keeping chained blocks around for reuse
+void cab_arena_reset(Cab_Arena *arena);
+// Empty the arena and free every block except the first one. Virtual arenas decommit their pages
+void cab_arena_release(Cab_Arena *arena);
 
+// Remember the current position of the arena
+Cab_Arena_Mark cab_arena_mark(Cab_Arena *arena);
+// Free everything allocated since mark was taken. Chained blocks are kept for reuse
+void cab_arena_rewind(Cab_Arena *arena, Cab_Arena_Mark mark);
+
+#endif // CAB_ARENA_H
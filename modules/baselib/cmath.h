@@ -1,6 +1,128 @@
 #ifndef SRC_MATH_H
 #define SRC_MATH_H
 #include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward
+#endif
+
+// SIMD backend, picked at compile time. Define CAB_MATH_SCALAR to force the scalar code.
+// Every SIMD path performs the same multiplies and adds in the same order as the scalar
+// reference, so results are bit-identical as long as the compiler does not contract the
+// scalar code into fused multiply-adds.
+#if !defined(CAB_MATH_SCALAR)
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define CAB_MATH_SSE
+#if defined(__AVX__)
+#define CAB_MATH_AVX
+#endif
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define CAB_MATH_NEON
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define CAB_MATH_WASM
+#endif
+#endif
+
+// Initial guess for 1/sqrt(x) from the float bits, refined with Newton steps by fast_rsqrtf
+#define CAB_RSQRT_MAGIC 0x5f375a86
+
+#if defined(CAB_MATH_SSE) || defined(CAB_MATH_NEON) || defined(CAB_MATH_WASM)
+#define CAB_MATH_SIMD
+
+// 4-wide float vector shared by all backends. cab_f32x4_clamp maps NaN to lo on every backend
+#if defined(CAB_MATH_SSE)
+typedef __m128 cab_f32x4;
+static inline cab_f32x4 cab_f32x4_load(const float *p) { return _mm_loadu_ps(p); }
+static inline void cab_f32x4_store(float *p, cab_f32x4 v) { _mm_storeu_ps(p, v); }
+static inline cab_f32x4 cab_f32x4_splat(float f) { return _mm_set1_ps(f); }
+static inline cab_f32x4 cab_f32x4_add(cab_f32x4 a, cab_f32x4 b) { return _mm_add_ps(a, b); }
+static inline cab_f32x4 cab_f32x4_sub(cab_f32x4 a, cab_f32x4 b) { return _mm_sub_ps(a, b); }
+static inline cab_f32x4 cab_f32x4_mul(cab_f32x4 a, cab_f32x4 b) { return _mm_mul_ps(a, b); }
+static inline cab_f32x4 cab_f32x4_min(cab_f32x4 a, cab_f32x4 b) { return _mm_min_ps(a, b); }
+static inline cab_f32x4 cab_f32x4_max(cab_f32x4 a, cab_f32x4 b) { return _mm_max_ps(a, b); }
+// maxps returns its second operand when either is NaN
+static inline cab_f32x4 cab_f32x4_clamp(cab_f32x4 v, cab_f32x4 lo, cab_f32x4 hi) { return _mm_min_ps(_mm_max_ps(v, lo), hi); }
+static inline cab_f32x4 cab_f32x4_rsqrt_seed(cab_f32x4 v) {
+  return _mm_castsi128_ps(_mm_sub_epi32(_mm_set1_epi32(CAB_RSQRT_MAGIC), _mm_srli_epi32(_mm_castps_si128(v), 1)));
+}
+#elif defined(CAB_MATH_NEON)
+typedef float32x4_t cab_f32x4;
+static inline cab_f32x4 cab_f32x4_load(const float *p) { return vld1q_f32(p); }
+static inline void cab_f32x4_store(float *p, cab_f32x4 v) { vst1q_f32(p, v); }
+static inline cab_f32x4 cab_f32x4_splat(float f) { return vdupq_n_f32(f); }
+static inline cab_f32x4 cab_f32x4_add(cab_f32x4 a, cab_f32x4 b) { return vaddq_f32(a, b); }
+static inline cab_f32x4 cab_f32x4_sub(cab_f32x4 a, cab_f32x4 b) { return vsubq_f32(a, b); }
+static inline cab_f32x4 cab_f32x4_mul(cab_f32x4 a, cab_f32x4 b) { return vmulq_f32(a, b); }
+static inline cab_f32x4 cab_f32x4_min(cab_f32x4 a, cab_f32x4 b) { return vminq_f32(a, b); }
+static inline cab_f32x4 cab_f32x4_max(cab_f32x4 a, cab_f32x4 b) { return vmaxq_f32(a, b); }
+#if defined(__aarch64__)
+static inline cab_f32x4 cab_f32x4_clamp(cab_f32x4 v, cab_f32x4 lo, cab_f32x4 hi) { return vminnmq_f32(vmaxnmq_f32(v, lo), hi); }
+#else
+// ARMv7 has no vmaxnmq_f32 and its vmaxq_f32 returns NaN for NaN lanes, so they are swapped for lo first
+static inline cab_f32x4 cab_f32x4_clamp(cab_f32x4 v, cab_f32x4 lo, cab_f32x4 hi) {
+  return vminq_f32(vmaxq_f32(vbslq_f32(vceqq_f32(v, v), v, lo), lo), hi);
+}
+#endif
+static inline cab_f32x4 cab_f32x4_rsqrt_seed(cab_f32x4 v) {
+  return vreinterpretq_f32_u32(vsubq_u32(vdupq_n_u32(CAB_RSQRT_MAGIC), vshrq_n_u32(vreinterpretq_u32_f32(v), 1)));
+}
+#elif defined(CAB_MATH_WASM)
+typedef v128_t cab_f32x4;
+static inline cab_f32x4 cab_f32x4_load(const float *p) { return wasm_v128_load(p); }
+static inline void cab_f32x4_store(float *p, cab_f32x4 v) { wasm_v128_store(p, v); }
+static inline cab_f32x4 cab_f32x4_splat(float f) { return wasm_f32x4_splat(f); }
+static inline cab_f32x4 cab_f32x4_add(cab_f32x4 a, cab_f32x4 b) { return wasm_f32x4_add(a, b); }
+static inline cab_f32x4 cab_f32x4_sub(cab_f32x4 a, cab_f32x4 b) { return wasm_f32x4_sub(a, b); }
+static inline cab_f32x4 cab_f32x4_mul(cab_f32x4 a, cab_f32x4 b) { return wasm_f32x4_mul(a, b); }
+static inline cab_f32x4 cab_f32x4_min(cab_f32x4 a, cab_f32x4 b) { return wasm_f32x4_pmin(a, b); }
+static inline cab_f32x4 cab_f32x4_max(cab_f32x4 a, cab_f32x4 b) { return wasm_f32x4_pmax(a, b); }
+static inline cab_f32x4 cab_f32x4_clamp(cab_f32x4 v, cab_f32x4 lo, cab_f32x4 hi) { return wasm_f32x4_pmin(wasm_f32x4_pmax(lo, v), hi); }
+static inline cab_f32x4 cab_f32x4_rsqrt_seed(cab_f32x4 v) {
+  return wasm_i32x4_sub(wasm_i32x4_splat(CAB_RSQRT_MAGIC), wasm_u32x4_shr(v, 1));
+}
+#endif
+
+static inline cab_f32x4 cab_f32x4_zero() { return cab_f32x4_splat(0.0f); }
+#endif
+
+// 8-wide float vector, AVX only. Plain AVX has no 256-bit integer ops, so the rsqrt seed
+// is computed on the two halves
+#if defined(CAB_MATH_AVX)
+typedef __m256 cab_f32x8;
+static inline cab_f32x8 cab_f32x8_load(const float *p) { return _mm256_loadu_ps(p); }
+static inline void cab_f32x8_store(float *p, cab_f32x8 v) { _mm256_storeu_ps(p, v); }
+static inline cab_f32x8 cab_f32x8_splat(float f) { return _mm256_set1_ps(f); }
+static inline cab_f32x8 cab_f32x8_add(cab_f32x8 a, cab_f32x8 b) { return _mm256_add_ps(a, b); }
+static inline cab_f32x8 cab_f32x8_sub(cab_f32x8 a, cab_f32x8 b) { return _mm256_sub_ps(a, b); }
+static inline cab_f32x8 cab_f32x8_mul(cab_f32x8 a, cab_f32x8 b) { return _mm256_mul_ps(a, b); }
+static inline cab_f32x8 cab_f32x8_max(cab_f32x8 a, cab_f32x8 b) { return _mm256_max_ps(a, b); }
+static inline cab_f32x8 cab_f32x8_rsqrt_seed(cab_f32x8 v) {
+  __m128 low = cab_f32x4_rsqrt_seed(_mm256_castps256_ps128(v));
+  __m128 high = cab_f32x4_rsqrt_seed(_mm256_extractf128_ps(v, 1));
+  return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+}
+#endif
+
+// Scalar versions of the vector helpers, so the fast approximations below can be written once
+static inline float cab_f32_splat(float f) { return f; }
+static inline float cab_f32_add(float a, float b) { return a + b; }
+static inline float cab_f32_sub(float a, float b) { return a - b; }
+static inline float cab_f32_mul(float a, float b) { return a * b; }
+static inline float cab_f32_max(float a, float b) { return a > b ? a : b; }
+static inline float cab_f32_rsqrt_seed(float f) {
+  union {
+    float f;
+    uint32_t u;
+  } bits = {f};
+  bits.u = CAB_RSQRT_MAGIC - (bits.u >> 1);
+  return bits.f;
+}
 
 typedef struct {
   float x, y;
@@ -60,22 +182,58 @@ static inline vec4 vec4_create(float x, float y, float z, float w) {
 
 // Function to add two vec4s
 static inline vec4 vec4_add(vec4 a, vec4 b) {
+#if defined(CAB_MATH_SIMD)
+  vec4 result;
+  cab_f32x4_store(&result.x, cab_f32x4_add(cab_f32x4_load(&a.x), cab_f32x4_load(&b.x)));
+  return result;
+#else
   return (vec4){a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+#endif
 }
 
 // Function to subtract two vec4s
 static inline vec4 vec4_sub(vec4 a, vec4 b) {
+#if defined(CAB_MATH_SIMD)
+  vec4 result;
+  cab_f32x4_store(&result.x, cab_f32x4_sub(cab_f32x4_load(&a.x), cab_f32x4_load(&b.x)));
+  return result;
+#else
   return (vec4){a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+#endif
 }
 
 // Function to scale a vec4 by a scalar
 static inline vec4 vec4_scale(vec4 v, float scalar) {
+#if defined(CAB_MATH_SIMD)
+  vec4 result;
+  cab_f32x4_store(&result.x, cab_f32x4_mul(cab_f32x4_load(&v.x), cab_f32x4_splat(scalar)));
+  return result;
+#else
   return (vec4){v.x * scalar, v.y * scalar, v.z * scalar, v.w * scalar};
+#endif
+}
+
+// Function to multiply two vec4s component-wise
+static inline vec4 vec4_mul(vec4 a, vec4 b) {
+#if defined(CAB_MATH_SIMD)
+  vec4 result;
+  cab_f32x4_store(&result.x, cab_f32x4_mul(cab_f32x4_load(&a.x), cab_f32x4_load(&b.x)));
+  return result;
+#else
+  return (vec4){a.x * b.x, a.y * b.y, a.z * b.z, a.w * b.w};
+#endif
 }
 
 // Function to compute the dot product of two vec4s
 static inline float vec4_dot(vec4 a, vec4 b) {
+#if defined(CAB_MATH_SIMD)
+  // Multiply in one go, then add the lanes in the same order as the scalar expression
+  float p[4];
+  cab_f32x4_store(p, cab_f32x4_mul(cab_f32x4_load(&a.x), cab_f32x4_load(&b.x)));
+  return p[0] + p[1] + p[2] + p[3];
+#else
   return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+#endif
 }
 
 // Function to compute the cross product of two vec4s
@@ -127,8 +285,8 @@ static inline void mat4_to_identity(mat4 *out) {
   out->elements[3][3] = 1.0f;
 }
 
-// Function to multiple two mat4s
-static inline void mat4_to_multiply(mat4 *out, mat4 *a, mat4 *b) {
+// Reference implementation of mat4_to_multiply, out must not alias a or b
+static inline void mat4_to_multiply_scalar(mat4 *out, mat4 *a, mat4 *b) {
   for (int col = 0; col < 4; col++) {
     for (int row = 0; row < 4; row++) {
       float sum = 0.0f;
@@ -140,6 +298,43 @@ static inline void mat4_to_multiply(mat4 *out, mat4 *a, mat4 *b) {
   }
 }
 
+// Function to multiple two mat4s
+// Each output column is a linear combination of the columns of a, weighted by a column of b
+static inline void mat4_to_multiply(mat4 *out, mat4 *a, mat4 *b) {
+#if defined(CAB_MATH_AVX)
+  // Two output columns per 8-wide register
+  __m256 a0 = _mm256_broadcast_ps((const __m128 *)a->elements[0]);
+  __m256 a1 = _mm256_broadcast_ps((const __m128 *)a->elements[1]);
+  __m256 a2 = _mm256_broadcast_ps((const __m128 *)a->elements[2]);
+  __m256 a3 = _mm256_broadcast_ps((const __m128 *)a->elements[3]);
+  for (int col = 0; col < 4; col += 2) {
+    __m256 bb = _mm256_loadu_ps(b->elements[col]);
+    __m256 sum = _mm256_setzero_ps();
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(a0, _mm256_permute_ps(bb, 0x00)));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(a1, _mm256_permute_ps(bb, 0x55)));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(a2, _mm256_permute_ps(bb, 0xAA)));
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(a3, _mm256_permute_ps(bb, 0xFF)));
+    _mm256_storeu_ps(out->elements[col], sum);
+  }
+#elif defined(CAB_MATH_SIMD)
+  cab_f32x4 a0 = cab_f32x4_load(a->elements[0]);
+  cab_f32x4 a1 = cab_f32x4_load(a->elements[1]);
+  cab_f32x4 a2 = cab_f32x4_load(a->elements[2]);
+  cab_f32x4 a3 = cab_f32x4_load(a->elements[3]);
+  for (int col = 0; col < 4; col++) {
+    const float *bc = b->elements[col];
+    cab_f32x4 sum = cab_f32x4_zero();
+    sum = cab_f32x4_add(sum, cab_f32x4_mul(a0, cab_f32x4_splat(bc[0])));
+    sum = cab_f32x4_add(sum, cab_f32x4_mul(a1, cab_f32x4_splat(bc[1])));
+    sum = cab_f32x4_add(sum, cab_f32x4_mul(a2, cab_f32x4_splat(bc[2])));
+    sum = cab_f32x4_add(sum, cab_f32x4_mul(a3, cab_f32x4_splat(bc[3])));
+    cab_f32x4_store(out->elements[col], sum);
+  }
+#else
+  mat4_to_multiply_scalar(out, a, b);
+#endif
+}
+
 // Function to multiply two mat4s
 static inline mat4 mat4_multiply(mat4 a, mat4 b) {
   mat4 result = mat4_create();
@@ -148,11 +343,42 @@ static inline mat4 mat4_multiply(mat4 a, mat4 b) {
 }
 
 static inline void mat4_to_transpose(mat4 *out, mat4 *m) {
+#if defined(CAB_MATH_SSE)
+  __m128 c0 = _mm_loadu_ps(m->elements[0]);
+  __m128 c1 = _mm_loadu_ps(m->elements[1]);
+  __m128 c2 = _mm_loadu_ps(m->elements[2]);
+  __m128 c3 = _mm_loadu_ps(m->elements[3]);
+  _MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+  _mm_storeu_ps(out->elements[0], c0);
+  _mm_storeu_ps(out->elements[1], c1);
+  _mm_storeu_ps(out->elements[2], c2);
+  _mm_storeu_ps(out->elements[3], c3);
+#elif defined(CAB_MATH_NEON)
+  float32x4x4_t columns = vld4q_f32(&m->elements[0][0]); // De-interleaving load is a transpose
+  vst1q_f32(out->elements[0], columns.val[0]);
+  vst1q_f32(out->elements[1], columns.val[1]);
+  vst1q_f32(out->elements[2], columns.val[2]);
+  vst1q_f32(out->elements[3], columns.val[3]);
+#elif defined(CAB_MATH_WASM)
+  v128_t c0 = wasm_v128_load(m->elements[0]);
+  v128_t c1 = wasm_v128_load(m->elements[1]);
+  v128_t c2 = wasm_v128_load(m->elements[2]);
+  v128_t c3 = wasm_v128_load(m->elements[3]);
+  v128_t t0 = wasm_i32x4_shuffle(c0, c1, 0, 4, 1, 5);
+  v128_t t1 = wasm_i32x4_shuffle(c2, c3, 0, 4, 1, 5);
+  v128_t t2 = wasm_i32x4_shuffle(c0, c1, 2, 6, 3, 7);
+  v128_t t3 = wasm_i32x4_shuffle(c2, c3, 2, 6, 3, 7);
+  wasm_v128_store(out->elements[0], wasm_i32x4_shuffle(t0, t1, 0, 1, 4, 5));
+  wasm_v128_store(out->elements[1], wasm_i32x4_shuffle(t0, t1, 2, 3, 6, 7));
+  wasm_v128_store(out->elements[2], wasm_i32x4_shuffle(t2, t3, 0, 1, 4, 5));
+  wasm_v128_store(out->elements[3], wasm_i32x4_shuffle(t2, t3, 2, 3, 6, 7));
+#else
   for (int col = 0; col < 4; col++) {
     for (int row = 0; row < 4; row++) {
       out->elements[row][col] = m->elements[col][row];
     }
   }
+#endif
 }
 
 // Function to transpose a mat4
@@ -162,6 +388,282 @@ static inline mat4 mat4_transpose(mat4 m) {
   return result;
 }
 
+// Function to transform a point (w = 1) by a mat4
+static inline vec3 mat4_transform_point(mat4 *m, vec3 p) {
+  return (vec3){
+      m->elements[0][0] * p.x + m->elements[1][0] * p.y + m->elements[2][0] * p.z + m->elements[3][0],
+      m->elements[0][1] * p.x + m->elements[1][1] * p.y + m->elements[2][1] * p.z + m->elements[3][1],
+      m->elements[0][2] * p.x + m->elements[1][2] * p.y + m->elements[2][2] * p.z + m->elements[3][2],
+  };
+}
+
+// Function to transform a direction (w = 0) by a mat4, ignoring the translation
+static inline vec3 mat4_transform_vector(mat4 *m, vec3 v) {
+  return (vec3){
+      m->elements[0][0] * v.x + m->elements[1][0] * v.y + m->elements[2][0] * v.z,
+      m->elements[0][1] * v.x + m->elements[1][1] * v.y + m->elements[2][1] * v.z,
+      m->elements[0][2] * v.x + m->elements[1][2] * v.y + m->elements[2][2] * v.z,
+  };
+}
+
+// Batch kernel behind the SoA and AoS transforms. translate selects points or directions.
+// The vector loops and the scalar tail use the same operation order, so every element gets
+// the same result as mat4_transform_point/vector no matter where it falls in the batch.
+static inline void mat4_transform_soa_kernel(mat4 *m, int translate, const float *x, const float *y, const float *z,
+                                             float *out_x, float *out_y, float *out_z, size_t count) {
+  size_t i = 0;
+#if defined(CAB_MATH_AVX)
+  {
+    __m256 m00 = _mm256_set1_ps(m->elements[0][0]), m01 = _mm256_set1_ps(m->elements[0][1]), m02 = _mm256_set1_ps(m->elements[0][2]);
+    __m256 m10 = _mm256_set1_ps(m->elements[1][0]), m11 = _mm256_set1_ps(m->elements[1][1]), m12 = _mm256_set1_ps(m->elements[1][2]);
+    __m256 m20 = _mm256_set1_ps(m->elements[2][0]), m21 = _mm256_set1_ps(m->elements[2][1]), m22 = _mm256_set1_ps(m->elements[2][2]);
+    __m256 m30 = _mm256_set1_ps(m->elements[3][0]), m31 = _mm256_set1_ps(m->elements[3][1]), m32 = _mm256_set1_ps(m->elements[3][2]);
+    for (; i + 8 <= count; i += 8) {
+      __m256 vx = _mm256_loadu_ps(x + i), vy = _mm256_loadu_ps(y + i), vz = _mm256_loadu_ps(z + i);
+      __m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, vx), _mm256_mul_ps(m10, vy)), _mm256_mul_ps(m20, vz));
+      __m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m01, vx), _mm256_mul_ps(m11, vy)), _mm256_mul_ps(m21, vz));
+      __m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m02, vx), _mm256_mul_ps(m12, vy)), _mm256_mul_ps(m22, vz));
+      if (translate) {
+        rx = _mm256_add_ps(rx, m30);
+        ry = _mm256_add_ps(ry, m31);
+        rz = _mm256_add_ps(rz, m32);
+      }
+      _mm256_storeu_ps(out_x + i, rx);
+      _mm256_storeu_ps(out_y + i, ry);
+      _mm256_storeu_ps(out_z + i, rz);
+    }
+  }
+#endif
+#if defined(CAB_MATH_SIMD)
+  {
+    cab_f32x4 m00 = cab_f32x4_splat(m->elements[0][0]), m01 = cab_f32x4_splat(m->elements[0][1]), m02 = cab_f32x4_splat(m->elements[0][2]);
+    cab_f32x4 m10 = cab_f32x4_splat(m->elements[1][0]), m11 = cab_f32x4_splat(m->elements[1][1]), m12 = cab_f32x4_splat(m->elements[1][2]);
+    cab_f32x4 m20 = cab_f32x4_splat(m->elements[2][0]), m21 = cab_f32x4_splat(m->elements[2][1]), m22 = cab_f32x4_splat(m->elements[2][2]);
+    cab_f32x4 m30 = cab_f32x4_splat(m->elements[3][0]), m31 = cab_f32x4_splat(m->elements[3][1]), m32 = cab_f32x4_splat(m->elements[3][2]);
+    for (; i + 4 <= count; i += 4) {
+      cab_f32x4 vx = cab_f32x4_load(x + i), vy = cab_f32x4_load(y + i), vz = cab_f32x4_load(z + i);
+      cab_f32x4 rx = cab_f32x4_add(cab_f32x4_add(cab_f32x4_mul(m00, vx), cab_f32x4_mul(m10, vy)), cab_f32x4_mul(m20, vz));
+      cab_f32x4 ry = cab_f32x4_add(cab_f32x4_add(cab_f32x4_mul(m01, vx), cab_f32x4_mul(m11, vy)), cab_f32x4_mul(m21, vz));
+      cab_f32x4 rz = cab_f32x4_add(cab_f32x4_add(cab_f32x4_mul(m02, vx), cab_f32x4_mul(m12, vy)), cab_f32x4_mul(m22, vz));
+      if (translate) {
+        rx = cab_f32x4_add(rx, m30);
+        ry = cab_f32x4_add(ry, m31);
+        rz = cab_f32x4_add(rz, m32);
+      }
+      cab_f32x4_store(out_x + i, rx);
+      cab_f32x4_store(out_y + i, ry);
+      cab_f32x4_store(out_z + i, rz);
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    vec3 p = {x[i], y[i], z[i]};
+    vec3 r = translate ? mat4_transform_point(m, p) : mat4_transform_vector(m, p);
+    out_x[i] = r.x;
+    out_y[i] = r.y;
+    out_z[i] = r.z;
+  }
+}
+
+// Function to transform count points stored as separate x, y and z arrays. Output may alias the input
+static inline void mat4_transform_points_soa(mat4 *m, const float *x, const float *y, const float *z,
+                                             float *out_x, float *out_y, float *out_z, size_t count) {
+  mat4_transform_soa_kernel(m, 1, x, y, z, out_x, out_y, out_z, count);
+}
+
+// Function to transform count directions stored as separate x, y and z arrays. Output may alias the input
+static inline void mat4_transform_vectors_soa(mat4 *m, const float *x, const float *y, const float *z,
+                                              float *out_x, float *out_y, float *out_z, size_t count) {
+  mat4_transform_soa_kernel(m, 0, x, y, z, out_x, out_y, out_z, count);
+}
+
+// Points per block when an AoS batch is swizzled through the SoA kernel
+#define CAB_TRANSFORM_BLOCK 64
+
+// AoS batches are split into blocks that are deinterleaved on the stack, run through the SoA
+// kernel and written back, which keeps the vector loops free of shuffles
+static inline void mat4_transform_aos_kernel(mat4 *m, int translate, const vec3 *in, vec3 *out, size_t count) {
+  float x[CAB_TRANSFORM_BLOCK], y[CAB_TRANSFORM_BLOCK], z[CAB_TRANSFORM_BLOCK];
+  for (size_t start = 0; start < count; start += CAB_TRANSFORM_BLOCK) {
+    size_t n = count - start < CAB_TRANSFORM_BLOCK ? count - start : CAB_TRANSFORM_BLOCK;
+    for (size_t i = 0; i < n; i++) {
+      x[i] = in[start + i].x;
+      y[i] = in[start + i].y;
+      z[i] = in[start + i].z;
+    }
+    mat4_transform_soa_kernel(m, translate, x, y, z, x, y, z, n);
+    for (size_t i = 0; i < n; i++) {
+      out[start + i] = (vec3){x[i], y[i], z[i]};
+    }
+  }
+}
+
+// Function to transform an array of count points. out may be the same array as in
+static inline void mat4_transform_points(mat4 *m, const vec3 *in, vec3 *out, size_t count) {
+  mat4_transform_aos_kernel(m, 1, in, out, count);
+}
+
+// Function to transform an array of count directions. out may be the same array as in
+static inline void mat4_transform_vectors(mat4 *m, const vec3 *in, vec3 *out, size_t count) {
+  mat4_transform_aos_kernel(m, 0, in, out, count);
+}
+
+// 2x2 determinants of rows r1 and r2 used by mat4_to_inverse
+static inline vec4 mat4_inverse_factor(mat4 *m, int r1, int r2) {
+  float (*e)[4] = m->elements;
+  vec4 a = vec4_mul((vec4){e[2][r1], e[2][r1], e[1][r1], e[1][r1]}, (vec4){e[3][r2], e[3][r2], e[3][r2], e[2][r2]});
+  vec4 b = vec4_mul((vec4){e[3][r1], e[3][r1], e[3][r1], e[2][r1]}, (vec4){e[2][r2], e[2][r2], e[1][r2], e[1][r2]});
+  return vec4_sub(a, b);
+}
+
+// Function to invert a mat4 with cofactors, computed four at a time with the vec4 operations.
+// Returns false and leaves out untouched when the matrix is singular. out must not alias m
+static inline bool mat4_to_inverse(mat4 *out, mat4 *m) {
+  float (*e)[4] = m->elements;
+  vec4 fac0 = mat4_inverse_factor(m, 2, 3);
+  vec4 fac1 = mat4_inverse_factor(m, 1, 3);
+  vec4 fac2 = mat4_inverse_factor(m, 1, 2);
+  vec4 fac3 = mat4_inverse_factor(m, 0, 3);
+  vec4 fac4 = mat4_inverse_factor(m, 0, 2);
+  vec4 fac5 = mat4_inverse_factor(m, 0, 1);
+  vec4 v0 = {e[1][0], e[0][0], e[0][0], e[0][0]};
+  vec4 v1 = {e[1][1], e[0][1], e[0][1], e[0][1]};
+  vec4 v2 = {e[1][2], e[0][2], e[0][2], e[0][2]};
+  vec4 v3 = {e[1][3], e[0][3], e[0][3], e[0][3]};
+  vec4 sign_a = {1.0f, -1.0f, 1.0f, -1.0f};
+  vec4 sign_b = {-1.0f, 1.0f, -1.0f, 1.0f};
+  vec4 inv0 = vec4_mul(vec4_add(vec4_sub(vec4_mul(v1, fac0), vec4_mul(v2, fac1)), vec4_mul(v3, fac2)), sign_a);
+  vec4 inv1 = vec4_mul(vec4_add(vec4_sub(vec4_mul(v0, fac0), vec4_mul(v2, fac3)), vec4_mul(v3, fac4)), sign_b);
+  vec4 inv2 = vec4_mul(vec4_add(vec4_sub(vec4_mul(v0, fac1), vec4_mul(v1, fac3)), vec4_mul(v3, fac5)), sign_a);
+  vec4 inv3 = vec4_mul(vec4_add(vec4_sub(vec4_mul(v0, fac2), vec4_mul(v1, fac4)), vec4_mul(v2, fac5)), sign_b);
+
+  // Laplace expansion along the first column
+  float det = vec4_dot((vec4){e[0][0], e[0][1], e[0][2], e[0][3]}, (vec4){inv0.x, inv1.x, inv2.x, inv3.x});
+  if (det == 0.0f) {
+    return false;
+  }
+  float inv_det = 1.0f / det;
+  vec4 columns[4] = {vec4_scale(inv0, inv_det), vec4_scale(inv1, inv_det), vec4_scale(inv2, inv_det), vec4_scale(inv3, inv_det)};
+  for (int col = 0; col < 4; col++) {
+    out->elements[col][0] = columns[col].x;
+    out->elements[col][1] = columns[col].y;
+    out->elements[col][2] = columns[col].z;
+    out->elements[col][3] = columns[col].w;
+  }
+  return true;
+}
+
+// Function to invert a mat4, the identity is returned for singular matrices
+static inline mat4 mat4_inverse(mat4 m) {
+  mat4 result = mat4_create();
+  mat4_to_inverse(&result, &m);
+  return result;
+}
+
+// Rows of the inverse of the upper 3x3 of m times its determinant, which is also the
+// cofactor matrix. Returns the determinant
+static inline float mat4_cofactors_3x3(mat4 *m, vec4 rows[3]) {
+  vec4 a0 = {m->elements[0][0], m->elements[0][1], m->elements[0][2], 0.0f};
+  vec4 a1 = {m->elements[1][0], m->elements[1][1], m->elements[1][2], 0.0f};
+  vec4 a2 = {m->elements[2][0], m->elements[2][1], m->elements[2][2], 0.0f};
+  rows[0] = vec4_cross(a1, a2);
+  rows[1] = vec4_cross(a2, a0);
+  rows[2] = vec4_cross(a0, a1);
+  return vec4_dot(a0, rows[0]);
+}
+
+// Function to invert an affine mat4, where the last row is 0, 0, 0, 1. Only inverts the
+// upper 3x3 and the translation, roughly a third of the work of mat4_to_inverse.
+// Returns false and leaves out untouched when the matrix is singular. out must not alias m
+static inline bool mat4_to_inverse_affine(mat4 *out, mat4 *m) {
+  vec4 rows[3];
+  float det = mat4_cofactors_3x3(m, rows);
+  if (det == 0.0f) {
+    return false;
+  }
+  float inv_det = 1.0f / det;
+  // The rows become the columns of a matrix that is transposed back in one go
+  mat4 columns;
+  for (int i = 0; i < 3; i++) {
+    vec4 row = vec4_scale(rows[i], inv_det);
+    columns.elements[i][0] = row.x;
+    columns.elements[i][1] = row.y;
+    columns.elements[i][2] = row.z;
+    columns.elements[i][3] = 0.0f;
+  }
+  columns.elements[3][0] = 0.0f;
+  columns.elements[3][1] = 0.0f;
+  columns.elements[3][2] = 0.0f;
+  columns.elements[3][3] = 0.0f;
+  mat4_to_transpose(out, &columns);
+
+  // Translation is the inverted upper 3x3 applied to the negated translation
+  vec4 t = {m->elements[3][0], m->elements[3][1], m->elements[3][2], 0.0f};
+  for (int i = 0; i < 3; i++) {
+    vec4 row = {columns.elements[i][0], columns.elements[i][1], columns.elements[i][2], 0.0f};
+    out->elements[3][i] = -vec4_dot(row, t);
+  }
+  out->elements[3][3] = 1.0f;
+  return true;
+}
+
+// Function to invert an affine mat4, the identity is returned for singular matrices
+static inline mat4 mat4_inverse_affine(mat4 m) {
+  mat4 result = mat4_create();
+  mat4_to_inverse_affine(&result, &m);
+  return result;
+}
+
+// Function to create the matrix that transforms normals for a model matrix, the inverse
+// transpose of its upper 3x3. Translation is dropped. Singular matrices get the plain
+// cofactor matrix, which still points normals the right way up to length
+static inline void mat4_to_normal_matrix(mat4 *out, mat4 *m) {
+  vec4 rows[3];
+  float det = mat4_cofactors_3x3(m, rows);
+  float scale = det != 0.0f ? 1.0f / det : 1.0f;
+  mat4_to_identity(out);
+  for (int i = 0; i < 3; i++) {
+    vec4 column = vec4_scale(rows[i], scale);
+    out->elements[i][0] = column.x;
+    out->elements[i][1] = column.y;
+    out->elements[i][2] = column.z;
+  }
+}
+
+// Function to create the matrix that transforms normals for a model matrix
+static inline mat4 mat4_normal_matrix(mat4 m) {
+  mat4 result;
+  mat4_to_normal_matrix(&result, &m);
+  return result;
+}
+
+// Function to map a point in normalized device coordinates (-1 to 1 on every axis) back to
+// world space, given the inverse of the view-projection matrix
+static inline vec3 mat4_unproject(mat4 *inv_view_proj, vec3 ndc) {
+  float (*e)[4] = inv_view_proj->elements;
+  vec4 p = vec4_add(vec4_add(vec4_scale((vec4){e[0][0], e[0][1], e[0][2], e[0][3]}, ndc.x),
+                             vec4_scale((vec4){e[1][0], e[1][1], e[1][2], e[1][3]}, ndc.y)),
+                    vec4_add(vec4_scale((vec4){e[2][0], e[2][1], e[2][2], e[2][3]}, ndc.z),
+                             (vec4){e[3][0], e[3][1], e[3][2], e[3][3]}));
+  float inv_w = 1.0f / p.w;
+  return (vec3){p.x * inv_w, p.y * inv_w, p.z * inv_w};
+}
+
+// Function to map a pixel position, origin top left, and a depth from -1 (near) to 1 (far)
+// back to world space, given the inverse of the view-projection matrix
+static inline vec3 mat4_unproject_screen(mat4 *inv_view_proj, float x, float y, float depth, float width, float height) {
+  vec3 ndc = {2.0f * x / width - 1.0f, 1.0f - 2.0f * y / height, depth};
+  return mat4_unproject(inv_view_proj, ndc);
+}
+
+// Function to build a picking ray through a pixel, from the near plane towards the far plane
+static inline void mat4_screen_ray(mat4 *inv_view_proj, float x, float y, float width, float height, vec3 *origin, vec3 *direction) {
+  vec3 near_point = mat4_unproject_screen(inv_view_proj, x, y, -1.0f, width, height);
+  vec3 far_point = mat4_unproject_screen(inv_view_proj, x, y, 1.0f, width, height);
+  *origin = near_point;
+  *direction = vec3_normalize(vec3_sub(far_point, near_point));
+}
+
 // Function to create a rotation matrix around the x-axis
 static inline void mat4_to_rotation_x(mat4 *out, float angle) {
   float c = cos(angle);
@@ -292,4 +794,651 @@ static inline mat4 mat4_ortho(float left, float right, float bottom, float top,
   return result;
 }
 
+// Rotation quaternion, w is the scalar part
+typedef struct {
+  float x, y, z, w;
+} quat;
+
+// Function to create the identity quaternion
+static inline quat quat_identity() {
+  return (quat){0.0f, 0.0f, 0.0f, 1.0f};
+}
+
+// Function to create a rotation of angle radians around a unit axis. It turns the same way
+// as mat4_rotation_x/y/z, so quat_from_axis_angle(x axis, a) gives mat4_rotation_x(a).
+static inline quat quat_from_axis_angle(vec3 axis, float angle) {
+  float s = sinf(angle * -0.5f);
+  return (quat){axis.x * s, axis.y * s, axis.z * s, cosf(angle * 0.5f)};
+}
+
+// Function to combine two rotations, the result applies b first and then a
+static inline quat quat_multiply(quat a, quat b) {
+  return (quat){
+      a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+      a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+      a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+      a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+  };
+}
+
+// Function to compute the inverse of a unit quaternion
+static inline quat quat_conjugate(quat q) {
+  return (quat){-q.x, -q.y, -q.z, q.w};
+}
+
+// Function to compute the dot product of two quaternions
+static inline float quat_dot(quat a, quat b) {
+  return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+// Function to normalize a quaternion
+static inline quat quat_normalize(quat q) {
+  float inv = 1.0f / sqrtf(quat_dot(q, q));
+  return (quat){q.x * inv, q.y * inv, q.z * inv, q.w * inv};
+}
+
+// Function to rotate a vec3 by a unit quaternion
+static inline vec3 quat_rotate(quat q, vec3 v) {
+  vec3 u = {q.x, q.y, q.z};
+  vec3 t = vec3_scale(vec3_cross(u, v), 2.0f);
+  return vec3_add(vec3_add(v, vec3_scale(t, q.w)), vec3_cross(u, t));
+}
+
+// Function to interpolate linearly and renormalize, taking the shorter way around.
+// Cheaper than slerp, but the angular speed is not constant over t
+static inline quat quat_nlerp(quat a, quat b, float t) {
+  float sign = quat_dot(a, b) < 0.0f ? -1.0f : 1.0f;
+  float s = 1.0f - t;
+  float u = t * sign;
+  return quat_normalize((quat){a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u});
+}
+
+// Function to interpolate at constant angular speed, taking the shorter way around
+static inline quat quat_slerp(quat a, quat b, float t) {
+  float d = quat_dot(a, b);
+  float sign = 1.0f;
+  if (d < 0.0f) {
+    d = -d;
+    sign = -1.0f;
+  }
+  // Nearly parallel, sin(theta) goes to zero and nlerp is just as accurate
+  if (d > 0.9995f) {
+    return quat_nlerp(a, b, t);
+  }
+  float theta = acosf(d);
+  float inv_sin = 1.0f / sinf(theta);
+  float s = sinf((1.0f - t) * theta) * inv_sin;
+  float u = sinf(t * theta) * inv_sin * sign;
+  return (quat){a.x * s + b.x * u, a.y * s + b.y * u, a.z * s + b.z * u, a.w * s + b.w * u};
+}
+
+// Function to create a rotation matrix from a unit quaternion
+static inline void mat4_to_quat(mat4 *out, quat q) {
+  float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+  float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+  float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+  mat4_to_identity(out);
+  out->elements[0][0] = 1.0f - 2.0f * (yy + zz);
+  out->elements[0][1] = 2.0f * (xy + wz);
+  out->elements[0][2] = 2.0f * (xz - wy);
+  out->elements[1][0] = 2.0f * (xy - wz);
+  out->elements[1][1] = 1.0f - 2.0f * (xx + zz);
+  out->elements[1][2] = 2.0f * (yz + wx);
+  out->elements[2][0] = 2.0f * (xz + wy);
+  out->elements[2][1] = 2.0f * (yz - wx);
+  out->elements[2][2] = 1.0f - 2.0f * (xx + yy);
+}
+
+// Function to create a rotation matrix from a unit quaternion
+static inline mat4 mat4_from_quat(quat q) {
+  mat4 result;
+  mat4_to_quat(&result, q);
+  return result;
+}
+
+// Translation, rotation and scale, applied scale first. 40 bytes against 64 for a mat4
+typedef struct {
+  vec3 translation;
+  quat rotation;
+  vec3 scale;
+} transform;
+
+// Function to create the identity transform
+static inline transform transform_identity() {
+  return (transform){{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+}
+
+// Function to build the T * R * S matrix of a transform directly, without any matrix products
+static inline void mat4_to_transform(mat4 *out, const transform *t) {
+  quat q = t->rotation;
+  float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+  float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+  float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+  float sx = t->scale.x, sy = t->scale.y, sz = t->scale.z;
+  out->elements[0][0] = (1.0f - 2.0f * (yy + zz)) * sx;
+  out->elements[0][1] = 2.0f * (xy + wz) * sx;
+  out->elements[0][2] = 2.0f * (xz - wy) * sx;
+  out->elements[0][3] = 0.0f;
+  out->elements[1][0] = 2.0f * (xy - wz) * sy;
+  out->elements[1][1] = (1.0f - 2.0f * (xx + zz)) * sy;
+  out->elements[1][2] = 2.0f * (yz + wx) * sy;
+  out->elements[1][3] = 0.0f;
+  out->elements[2][0] = 2.0f * (xz + wy) * sz;
+  out->elements[2][1] = 2.0f * (yz - wx) * sz;
+  out->elements[2][2] = (1.0f - 2.0f * (xx + yy)) * sz;
+  out->elements[2][3] = 0.0f;
+  out->elements[3][0] = t->translation.x;
+  out->elements[3][1] = t->translation.y;
+  out->elements[3][2] = t->translation.z;
+  out->elements[3][3] = 1.0f;
+}
+
+// Function to build the T * R * S matrix of a transform directly, without any matrix products
+static inline mat4 mat4_from_transform(transform t) {
+  mat4 result;
+  mat4_to_transform(&result, &t);
+  return result;
+}
+
+// Function to transform a point by a transform
+static inline vec3 transform_point(transform t, vec3 p) {
+  vec3 scaled = {p.x * t.scale.x, p.y * t.scale.y, p.z * t.scale.z};
+  return vec3_add(quat_rotate(t.rotation, scaled), t.translation);
+}
+
+// Function to apply child and then parent. Only exact when the parent scale is uniform,
+// a non-uniform scale under a rotation is a shear that TRS cannot represent
+static inline transform transform_combine(transform parent, transform child) {
+  return (transform){
+      .translation = transform_point(parent, child.translation),
+      .rotation = quat_multiply(parent.rotation, child.rotation),
+      .scale = {parent.scale.x * child.scale.x, parent.scale.y * child.scale.y, parent.scale.z * child.scale.z},
+  };
+}
+
+// Function to build the matrices of count transforms
+static inline void mat4_to_transforms(mat4 *out, const transform *in, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    mat4_to_transform(&out[i], &in[i]);
+  }
+}
+
+// Function to resolve a hierarchy into world matrices. parents[i] is the index of the parent
+// of node i, or -1 for a root, and must be smaller than i so parents are resolved first
+static inline void mat4_to_transform_hierarchy(mat4 *world, const transform *local, const int32_t *parents, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (parents[i] < 0) {
+      mat4_to_transform(&world[i], &local[i]);
+    } else {
+      mat4 local_matrix;
+      mat4_to_transform(&local_matrix, &local[i]);
+      mat4_to_multiply(&world[i], &world[parents[i]], &local_matrix);
+    }
+  }
+}
+
+// Six planes with normals pointing inwards, a point p is inside a plane when
+// x * p.x + y * p.y + z * p.z + w >= 0. Normals are unit length, so w is a distance.
+typedef struct {
+  vec4 planes[6]; // Left, right, bottom, top, near, far
+} frustum;
+
+// Function to extract the frustum of a view-projection or MVP matrix with OpenGL clip space
+// (-w <= z <= w). Objects tested against it must be in the space the matrix transforms from.
+static inline void frustum_to_mat4(frustum *out, mat4 *m) {
+  for (int i = 0; i < 6; i++) {
+    int row = i / 2;
+    float sign = (i & 1) ? -1.0f : 1.0f;
+    vec4 plane = {
+        m->elements[0][3] + sign * m->elements[0][row],
+        m->elements[1][3] + sign * m->elements[1][row],
+        m->elements[2][3] + sign * m->elements[2][row],
+        m->elements[3][3] + sign * m->elements[3][row],
+    };
+    float inv_length = 1.0f / sqrtf(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+    out->planes[i] = (vec4){plane.x * inv_length, plane.y * inv_length, plane.z * inv_length, plane.w * inv_length};
+  }
+}
+
+// Function to extract the frustum of a view-projection or MVP matrix
+static inline frustum frustum_from_mat4(mat4 m) {
+  frustum result;
+  frustum_to_mat4(&result, &m);
+  return result;
+}
+
+// Function to test a sphere against a frustum, true when it is at least partly inside
+static inline bool frustum_test_sphere(const frustum *f, vec3 center, float radius) {
+  for (int i = 0; i < 6; i++) {
+    const vec4 *p = &f->planes[i];
+    if (p->x * center.x + p->y * center.y + p->z * center.z + p->w + radius < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Function to test an AABB given as center and half extents against a frustum, true when it
+// is at least partly inside. Boxes near the frustum corners can be reported visible
+// when they are not, which is fine for culling
+static inline bool frustum_test_aabb(const frustum *f, vec3 center, vec3 extents) {
+  for (int i = 0; i < 6; i++) {
+    const vec4 *p = &f->planes[i];
+    float r = fabsf(p->x) * extents.x + fabsf(p->y) * extents.y + fabsf(p->z) * extents.z;
+    if (p->x * center.x + p->y * center.y + p->z * center.z + p->w + r < 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Number of uint32_t words in a visibility mask for count objects
+#define FRUSTUM_MASK_WORDS(count) (((count) + 31) / 32)
+
+// Batch kernel behind the sphere and AABB culls. Bit i of mask is set when object i is
+// visible. Spheres pass their radius in ex and NULL for ey and ez, boxes their half extents.
+static inline void frustum_cull_kernel(const frustum *f, const float *x, const float *y, const float *z,
+                                       const float *ex, const float *ey, const float *ez, size_t count, uint32_t *mask) {
+  for (size_t i = 0; i < FRUSTUM_MASK_WORDS(count); i++) {
+    mask[i] = 0;
+  }
+  // Per plane projected radius weights: the radius as is for spheres, |normal| for boxes
+  float wx[6], wy[6], wz[6];
+  for (int p = 0; p < 6; p++) {
+    wx[p] = ey ? fabsf(f->planes[p].x) : 1.0f;
+    wy[p] = ey ? fabsf(f->planes[p].y) : 0.0f;
+    wz[p] = ey ? fabsf(f->planes[p].z) : 0.0f;
+  }
+  size_t i = 0;
+#if defined(CAB_MATH_SIMD)
+  for (; i + 4 <= count; i += 4) {
+    cab_f32x4 cx = cab_f32x4_load(x + i), cy = cab_f32x4_load(y + i), cz = cab_f32x4_load(z + i);
+    cab_f32x4 rx = cab_f32x4_load(ex + i);
+    cab_f32x4 ry = ey ? cab_f32x4_load(ey + i) : cab_f32x4_zero();
+    cab_f32x4 rz = ez ? cab_f32x4_load(ez + i) : cab_f32x4_zero();
+    cab_f32x4 nearest = cab_f32x4_splat(INFINITY);
+    for (int p = 0; p < 6; p++) {
+      const vec4 *plane = &f->planes[p];
+      cab_f32x4 d = cab_f32x4_add(cab_f32x4_mul(cab_f32x4_splat(plane->x), cx), cab_f32x4_mul(cab_f32x4_splat(plane->y), cy));
+      d = cab_f32x4_add(cab_f32x4_add(d, cab_f32x4_mul(cab_f32x4_splat(plane->z), cz)), cab_f32x4_splat(plane->w));
+      cab_f32x4 r = cab_f32x4_add(cab_f32x4_mul(cab_f32x4_splat(wx[p]), rx), cab_f32x4_mul(cab_f32x4_splat(wy[p]), ry));
+      r = cab_f32x4_add(r, cab_f32x4_mul(cab_f32x4_splat(wz[p]), rz));
+      nearest = cab_f32x4_min(nearest, cab_f32x4_add(d, r));
+    }
+    float result[4];
+    cab_f32x4_store(result, nearest);
+    for (int lane = 0; lane < 4; lane++) {
+      mask[(i + lane) / 32] |= (uint32_t)(result[lane] >= 0.0f) << ((i + lane) % 32);
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    float rx = ex[i], ry = ey ? ey[i] : 0.0f, rz = ez ? ez[i] : 0.0f;
+    bool visible = true;
+    for (int p = 0; p < 6; p++) {
+      const vec4 *plane = &f->planes[p];
+      float d = plane->x * x[i] + plane->y * y[i] + plane->z * z[i] + plane->w;
+      float r = wx[p] * rx + wy[p] * ry + wz[p] * rz;
+      visible &= d + r >= 0.0f;
+    }
+    mask[i / 32] |= (uint32_t)visible << (i % 32);
+  }
+}
+
+// Function to cull count spheres stored as separate center and radius arrays.
+// mask needs FRUSTUM_MASK_WORDS(count) words
+static inline void frustum_cull_spheres(const frustum *f, const float *x, const float *y, const float *z,
+                                        const float *radius, size_t count, uint32_t *mask) {
+  frustum_cull_kernel(f, x, y, z, radius, NULL, NULL, count, mask);
+}
+
+// Function to cull count AABBs stored as separate center and half extent arrays.
+// mask needs FRUSTUM_MASK_WORDS(count) words
+static inline void frustum_cull_aabbs(const frustum *f, const float *x, const float *y, const float *z,
+                                      const float *ex, const float *ey, const float *ez, size_t count, uint32_t *mask) {
+  frustum_cull_kernel(f, x, y, z, ex, ey, ez, count, mask);
+}
+
+// Function to compact a visibility mask into the indices of the visible objects, in order.
+// Returns how many were written, indices needs room for count entries
+static inline size_t frustum_mask_to_indices(const uint32_t *mask, size_t count, uint32_t *indices) {
+  size_t written = 0;
+  for (size_t word = 0; word < FRUSTUM_MASK_WORDS(count); word++) {
+    for (uint32_t bits = mask[word]; bits; bits &= bits - 1) {
+#if defined(_MSC_VER)
+      unsigned long bit;
+      _BitScanForward(&bit, bits);
+#else
+      int bit = __builtin_ctz(bits);
+#endif
+      indices[written++] = (uint32_t)(word * 32 + bit);
+    }
+  }
+  return written;
+}
+
+// --- Fast approximations ---
+// Branch-free polynomial versions of sin, cos, sqrt and 1/sqrt, with no libm calls. They are
+// defined once for float, cab_f32x4 and cab_f32x8 from the same operations, so every width
+// returns bit-identical results. Measured against double precision libm:
+//   fast_sinf, fast_cosf    absolute error below 2e-7 for |x| <= 8192, degrading slowly past that.
+//                           Past 2^22 the range reduction breaks down and results are garbage
+//   fast_rsqrtf             relative error below 5e-6 for positive normal floats
+//   fast_sqrtf              relative error below 5e-6 for positive normal floats, exact 0 for 0
+// sqrtf is a single instruction on most targets, fast_sqrtf mostly exists for the vector widths.
+
+// pi split in three so k * pi can be subtracted without losing bits (Cody-Waite)
+#define CAB_FAST_PI_A 3.140625f
+#define CAB_FAST_PI_B 9.67502593994140625e-4f
+#define CAB_FAST_PI_C 1.509957990978376432e-7f
+#define CAB_FAST_INV_PI 0.318309886183790671f
+// Adding and subtracting 1.5 * 2^23 rounds to the nearest integer
+#define CAB_FAST_ROUND 12582912.0f
+
+#define CAB_FAST_MATH_DEFINE(T, suffix, P)                                                       \
+  /* sin(r) for r in [-pi/2, pi/2], Taylor series up to r^11 */                                  \
+  static inline T cab_fast_sin_poly##suffix(T r) {                                               \
+    T r2 = P##_mul(r, r);                                                                        \
+    T p = P##_splat(-2.5052108385441720e-8f);                                                    \
+    p = P##_add(P##_mul(p, r2), P##_splat(2.7557319223985893e-6f));                              \
+    p = P##_add(P##_mul(p, r2), P##_splat(-1.9841269841269841e-4f));                             \
+    p = P##_add(P##_mul(p, r2), P##_splat(8.3333333333333333e-3f));                              \
+    p = P##_add(P##_mul(p, r2), P##_splat(-1.6666666666666667e-1f));                             \
+    return P##_add(r, P##_mul(P##_mul(r, r2), p));                                               \
+  }                                                                                              \
+  /* (-1)^k for an integral k: half of k has a fractional part of 0 or 0.5 */                    \
+  static inline T cab_fast_parity_sign##suffix(T k) {                                            \
+    T h = P##_mul(k, P##_splat(0.5f));                                                           \
+    T f = P##_sub(h, P##_sub(P##_add(h, P##_splat(CAB_FAST_ROUND)), P##_splat(CAB_FAST_ROUND))); \
+    return P##_sub(P##_splat(1.0f), P##_mul(P##_splat(8.0f), P##_mul(f, f)));                    \
+  }                                                                                              \
+  /* x - m * pi for an integral or half-integral m */                                            \
+  static inline T cab_fast_reduce##suffix(T x, T m) {                                            \
+    T r = P##_sub(x, P##_mul(m, P##_splat(CAB_FAST_PI_A)));                                      \
+    r = P##_sub(r, P##_mul(m, P##_splat(CAB_FAST_PI_B)));                                        \
+    return P##_sub(r, P##_mul(m, P##_splat(CAB_FAST_PI_C)));                                     \
+  }                                                                                              \
+  /* sin(x) = (-1)^k sin(x - k pi) with k = round(x / pi) */                                     \
+  static inline T fast_sin##suffix(T x) {                                                        \
+    T k = P##_mul(x, P##_splat(CAB_FAST_INV_PI));                                                \
+    k = P##_sub(P##_add(k, P##_splat(CAB_FAST_ROUND)), P##_splat(CAB_FAST_ROUND));               \
+    T s = cab_fast_sin_poly##suffix(cab_fast_reduce##suffix(x, k));                              \
+    return P##_mul(s, cab_fast_parity_sign##suffix(k));                                          \
+  }                                                                                              \
+  /* cos(x) = (-1)^(k+1) sin(x - (k + 0.5) pi) with k = round(x / pi - 0.5) */                   \
+  static inline T fast_cos##suffix(T x) {                                                        \
+    T k = P##_sub(P##_mul(x, P##_splat(CAB_FAST_INV_PI)), P##_splat(0.5f));                      \
+    k = P##_sub(P##_add(k, P##_splat(CAB_FAST_ROUND)), P##_splat(CAB_FAST_ROUND));               \
+    T s = cab_fast_sin_poly##suffix(cab_fast_reduce##suffix(x, P##_add(k, P##_splat(0.5f))));    \
+    return P##_mul(s, P##_sub(P##_splat(0.0f), cab_fast_parity_sign##suffix(k)));                \
+  }                                                                                              \
+  /* Bit-level estimate refined with two Newton steps y = y * (1.5 - 0.5 * x * y * y) */         \
+  static inline T fast_rsqrt##suffix(T x) {                                                      \
+    T half = P##_mul(x, P##_splat(0.5f));                                                        \
+    T y = P##_rsqrt_seed(x);                                                                     \
+    y = P##_mul(y, P##_sub(P##_splat(1.5f), P##_mul(half, P##_mul(y, y))));                      \
+    y = P##_mul(y, P##_sub(P##_splat(1.5f), P##_mul(half, P##_mul(y, y))));                      \
+    return y;                                                                                    \
+  }                                                                                              \
+  /* x * rsqrt(x), clamped so 0 does not turn into 0 * inf */                                    \
+  static inline T fast_sqrt##suffix(T x) {                                                       \
+    return P##_mul(x, fast_rsqrt##suffix(P##_max(x, P##_splat(1.17549435e-38f))));               \
+  }
+
+CAB_FAST_MATH_DEFINE(float, f, cab_f32)
+#if defined(CAB_MATH_SIMD)
+CAB_FAST_MATH_DEFINE(cab_f32x4, _f32x4, cab_f32x4)
+#endif
+#if defined(CAB_MATH_AVX)
+CAB_FAST_MATH_DEFINE(cab_f32x8, _f32x8, cab_f32x8)
+#endif
+
+// Array versions, out may be the same array as in
+#if defined(CAB_MATH_AVX)
+#define CAB_FAST_BATCH_WIDE(name, in, out, i, count)                \
+  for (; i + 8 <= count; i += 8) {                                  \
+    cab_f32x8_store(out + i, name##_f32x8(cab_f32x8_load(in + i))); \
+  }
+#else
+#define CAB_FAST_BATCH_WIDE(name, in, out, i, count)
+#endif
+#if defined(CAB_MATH_SIMD)
+#define CAB_FAST_BATCH_SIMD(name, in, out, i, count)                \
+  for (; i + 4 <= count; i += 4) {                                  \
+    cab_f32x4_store(out + i, name##_f32x4(cab_f32x4_load(in + i))); \
+  }
+#else
+#define CAB_FAST_BATCH_SIMD(name, in, out, i, count)
+#endif
+#define CAB_FAST_BATCH_DEFINE(name)                                             \
+  static inline void name##f_batch(const float *in, float *out, size_t count) { \
+    size_t i = 0;                                                               \
+    CAB_FAST_BATCH_WIDE(name, in, out, i, count)                                \
+    CAB_FAST_BATCH_SIMD(name, in, out, i, count)                                \
+    for (; i < count; i++) {                                                    \
+      out[i] = name##f(in[i]);                                                  \
+    }                                                                           \
+  }
+
+CAB_FAST_BATCH_DEFINE(fast_sin)
+CAB_FAST_BATCH_DEFINE(fast_cos)
+CAB_FAST_BATCH_DEFINE(fast_rsqrt)
+CAB_FAST_BATCH_DEFINE(fast_sqrt)
+
+// --- Packing ---
+// Conversions to the compact vertex formats sokol_gfx understands: HALF2/4, BYTE4N, UBYTE4N,
+// SHORT2/4N, USHORT2/4N and UINT10_N2. Normalized values are clamped to their range first,
+// NaN packs as the low end of the range, and rounding is to nearest even everywhere, so the
+// batched SIMD versions give bit-identical results to the scalar ones.
+
+// Function to round a float in [-2^22, 2^22] to the nearest integer, ties to even
+static inline float cab_round_even(float f) {
+  return (f + CAB_FAST_ROUND) - CAB_FAST_ROUND;
+}
+
+static inline float cab_clamp_norm(float f, float lo) {
+  float c = f > lo ? f : lo;
+  return c < 1.0f ? c : 1.0f;
+}
+
+// Function to convert a float to IEEE half precision bits. Overflow becomes infinity, NaN stays a quiet NaN
+static inline uint16_t pack_half(float f) {
+  union {
+    float f;
+    uint32_t u;
+  } bits = {f};
+  uint32_t sign = (bits.u >> 16) & 0x8000;
+  bits.u &= 0x7fffffff;
+  uint32_t half;
+  if (bits.u >= 0x47800000) {
+    // Past the largest half exponent, which also covers infinity and NaN
+    half = bits.u > 0x7f800000 ? 0x7e00 : 0x7c00;
+  } else if (bits.u < 0x38800000) {
+    // Below the smallest normal half. Adding 0.5 lines the mantissa up with the half
+    // denormal bits and lets the float adder do the rounding
+    union {
+      float f;
+      uint32_t u;
+    } magic = {0.5f};
+    bits.f += magic.f;
+    half = bits.u - magic.u;
+  } else {
+    // Rebias the exponent and round the 13 dropped mantissa bits to nearest even
+    uint32_t odd = (bits.u >> 13) & 1;
+    bits.u += 0xc8000fff + odd;
+    half = bits.u >> 13;
+  }
+  return (uint16_t)(half | sign);
+}
+
+// Function to convert IEEE half precision bits to a float, exact for every input
+static inline float unpack_half(uint16_t h) {
+  union {
+    float f;
+    uint32_t u;
+  } bits = {0}, magic = {0};
+  magic.u = 113 << 23;
+  bits.u = (uint32_t)(h & 0x7fff) << 13;
+  uint32_t exponent = bits.u & 0x0f800000;
+  bits.u += (127 - 15) << 23;
+  if (exponent == 0x0f800000) {
+    bits.u += (128 - 16) << 23; // Infinity or NaN
+  } else if (exponent == 0) {
+    bits.u += 1 << 23;          // Zero or denormal, renormalized by the subtraction
+    bits.f -= magic.f;
+  }
+  bits.u |= (uint32_t)(h & 0x8000) << 16;
+  return bits.f;
+}
+
+// Function to pack a float in [-1, 1] to a signed normalized byte
+static inline int8_t pack_snorm8(float f) {
+  return (int8_t)cab_round_even(cab_clamp_norm(f, -1.0f) * 127.0f);
+}
+
+// Function to pack a float in [0, 1] to an unsigned normalized byte
+static inline uint8_t pack_unorm8(float f) {
+  return (uint8_t)cab_round_even(cab_clamp_norm(f, 0.0f) * 255.0f);
+}
+
+// Function to pack a float in [-1, 1] to a signed normalized short
+static inline int16_t pack_snorm16(float f) {
+  return (int16_t)cab_round_even(cab_clamp_norm(f, -1.0f) * 32767.0f);
+}
+
+// Function to pack a float in [0, 1] to an unsigned normalized short
+static inline uint16_t pack_unorm16(float f) {
+  return (uint16_t)cab_round_even(cab_clamp_norm(f, 0.0f) * 65535.0f);
+}
+
+// Functions to unpack normalized integers the way the GPU does, -128 and -32768 map to -1
+static inline float unpack_snorm8(int8_t v) {
+  float f = v / 127.0f;
+  return f > -1.0f ? f : -1.0f;
+}
+
+static inline float unpack_unorm8(uint8_t v) {
+  return v / 255.0f;
+}
+
+static inline float unpack_snorm16(int16_t v) {
+  float f = v / 32767.0f;
+  return f > -1.0f ? f : -1.0f;
+}
+
+static inline float unpack_unorm16(uint16_t v) {
+  return v / 65535.0f;
+}
+
+// Function to pack a vec4 in [0, 1] to 10 bits each for x, y and z and 2 bits for w, x in the low bits
+static inline uint32_t pack_unorm_10_10_10_2(vec4 v) {
+  uint32_t x = (uint32_t)cab_round_even(cab_clamp_norm(v.x, 0.0f) * 1023.0f);
+  uint32_t y = (uint32_t)cab_round_even(cab_clamp_norm(v.y, 0.0f) * 1023.0f);
+  uint32_t z = (uint32_t)cab_round_even(cab_clamp_norm(v.z, 0.0f) * 1023.0f);
+  uint32_t w = (uint32_t)cab_round_even(cab_clamp_norm(v.w, 0.0f) * 3.0f);
+  return x | (y << 10) | (z << 20) | (w << 30);
+}
+
+// Function to unpack 10-10-10-2 normalized bits to a vec4
+static inline vec4 unpack_unorm_10_10_10_2(uint32_t packed) {
+  return (vec4){
+      (packed & 0x3ff) / 1023.0f,
+      ((packed >> 10) & 0x3ff) / 1023.0f,
+      ((packed >> 20) & 0x3ff) / 1023.0f,
+      (packed >> 30) / 3.0f,
+  };
+}
+
+// Batch kernel behind the normalized packers: clamps count floats to [lo, 1], scales and
+// rounds them, leaving integral values in out for the caller to narrow
+static inline void cab_pack_norm_kernel(const float *in, float *out, size_t count, float lo, float scale) {
+  size_t i = 0;
+#if defined(CAB_MATH_SIMD)
+  cab_f32x4 vlo = cab_f32x4_splat(lo), vhi = cab_f32x4_splat(1.0f), vscale = cab_f32x4_splat(scale);
+  cab_f32x4 vround = cab_f32x4_splat(CAB_FAST_ROUND);
+  for (; i + 4 <= count; i += 4) {
+    cab_f32x4 v = cab_f32x4_mul(cab_f32x4_clamp(cab_f32x4_load(in + i), vlo, vhi), vscale);
+    cab_f32x4_store(out + i, cab_f32x4_sub(cab_f32x4_add(v, vround), vround));
+  }
+#endif
+  for (; i < count; i++) {
+    out[i] = cab_round_even(cab_clamp_norm(in[i], lo) * scale);
+  }
+}
+
+// Floats per stack block in the batched packers
+#define CAB_PACK_BLOCK 64
+
+// Array versions of the normalized packers
+#define CAB_PACK_NORM_BATCH_DEFINE(name, T, lo, scale)                                  \
+  static inline void pack_##name##_batch(const float *in, T *out, size_t count) {       \
+    float rounded[CAB_PACK_BLOCK];                                                    \
+    for (size_t start = 0; start < count; start += CAB_PACK_BLOCK) {                  \
+      size_t n = count - start < CAB_PACK_BLOCK ? count - start : CAB_PACK_BLOCK;     \
+      cab_pack_norm_kernel(in + start, rounded, n, lo, scale);                        \
+      for (size_t i = 0; i < n; i++) {                                                \
+        out[start + i] = (T)rounded[i];                                               \
+      }                                                                               \
+    }                                                                                 \
+  }
+
+CAB_PACK_NORM_BATCH_DEFINE(snorm8, int8_t, -1.0f, 127.0f)
+CAB_PACK_NORM_BATCH_DEFINE(unorm8, uint8_t, 0.0f, 255.0f)
+CAB_PACK_NORM_BATCH_DEFINE(snorm16, int16_t, -1.0f, 32767.0f)
+CAB_PACK_NORM_BATCH_DEFINE(unorm16, uint16_t, 0.0f, 65535.0f)
+
+// Function to pack count vec4s to 10-10-10-2, one vec4 per vector operation
+static inline void pack_unorm_10_10_10_2_batch(const vec4 *in, uint32_t *out, size_t count) {
+#if defined(CAB_MATH_SIMD)
+  static const float scale[4] = {1023.0f, 1023.0f, 1023.0f, 3.0f};
+  cab_f32x4 vlo = cab_f32x4_zero(), vhi = cab_f32x4_splat(1.0f), vscale = cab_f32x4_load(scale);
+  cab_f32x4 vround = cab_f32x4_splat(CAB_FAST_ROUND);
+  for (size_t i = 0; i < count; i++) {
+    float r[4];
+    cab_f32x4 v = cab_f32x4_mul(cab_f32x4_clamp(cab_f32x4_load(&in[i].x), vlo, vhi), vscale);
+    cab_f32x4_store(r, cab_f32x4_sub(cab_f32x4_add(v, vround), vround));
+    out[i] = (uint32_t)r[0] | ((uint32_t)r[1] << 10) | ((uint32_t)r[2] << 20) | ((uint32_t)r[3] << 30);
+  }
+#else
+  for (size_t i = 0; i < count; i++) {
+    out[i] = pack_unorm_10_10_10_2(in[i]);
+  }
+#endif
+}
+
+// Function to convert count floats to half precision. Uses F16C or NEON conversions when
+// the target has them, both round to nearest even like pack_half
+static inline void pack_half_batch(const float *in, uint16_t *out, size_t count) {
+  size_t i = 0;
+#if defined(CAB_MATH_SSE) && defined(__F16C__)
+  for (; i + 4 <= count; i += 4) {
+    _mm_storel_epi64((__m128i *)(out + i), _mm_cvtps_ph(_mm_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+  }
+#elif defined(CAB_MATH_NEON) && defined(__aarch64__)
+  for (; i + 4 <= count; i += 4) {
+    vst1_u16(out + i, vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(in + i))));
+  }
+#endif
+  for (; i < count; i++) {
+    out[i] = pack_half(in[i]);
+  }
+}
+
+// Function to convert count half precision values to floats
+static inline void unpack_half_batch(const uint16_t *in, float *out, size_t count) {
+  size_t i = 0;
+#if defined(CAB_MATH_SSE) && defined(__F16C__)
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(out + i, _mm_cvtph_ps(_mm_loadl_epi64((const __m128i *)(in + i))));
+  }
+#elif defined(CAB_MATH_NEON) && defined(__aarch64__)
+  for (; i + 4 <= count; i += 4) {
+    vst1q_f32(out + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(in + i))));
+  }
+#endif
+  for (; i < count; i++) {
+    out[i] = unpack_half(in[i]);
+  }
+}
+
 #endif // SRC_MATH_H
@@ -0,0 +1,334 @@
+#include "hash_map.h"
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h> // _BitScanForward
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define GROUP_SSE2
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GROUP_NEON
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define GROUP_WASM
+#endif
+
+#define CTRL_EMPTY ((int8_t)-128)
+#define CTRL_DELETED ((int8_t)-2)
+#define MIN_CAPACITY CAB_HASH_MAP_GROUP_SIZE
+
+// --- Group matching ---
+// Every function returns a bitmask with bit i set when control byte i of the group matches.
+
+#if defined(GROUP_SSE2)
+
+static inline uint32_t group_match(const int8_t *ctrl, int8_t h2) {
+    __m128i group = _mm_load_si128((const __m128i *)ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+}
+
+static inline uint32_t group_match_empty(const int8_t *ctrl) {
+    return group_match(ctrl, CTRL_EMPTY);
+}
+
+// Empty and deleted are the only control bytes with the sign bit set
+static inline uint32_t group_match_empty_or_deleted(const int8_t *ctrl) {
+    return (uint32_t)_mm_movemask_epi8(_mm_load_si128((const __m128i *)ctrl));
+}
+
+#elif defined(GROUP_NEON)
+
+static inline uint32_t neon_movemask(uint8x16_t mask) {
+    static const uint8_t bits[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t masked = vandq_u8(mask, vld1q_u8(bits));
+    return (uint32_t)vaddv_u8(vget_low_u8(masked)) | ((uint32_t)vaddv_u8(vget_high_u8(masked)) << 8);
+}
+
+static inline uint32_t group_match(const int8_t *ctrl, int8_t h2) {
+    return neon_movemask(vceqq_s8(vld1q_s8(ctrl), vdupq_n_s8(h2)));
+}
+
+static inline uint32_t group_match_empty(const int8_t *ctrl) {
+    return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline uint32_t group_match_empty_or_deleted(const int8_t *ctrl) {
+    return neon_movemask(vcltzq_s8(vld1q_s8(ctrl)));
+}
+
+#elif defined(GROUP_WASM)
+
+static inline uint32_t group_match(const int8_t *ctrl, int8_t h2) {
+    return wasm_i8x16_bitmask(wasm_i8x16_eq(wasm_v128_load(ctrl), wasm_i8x16_splat(h2)));
+}
+
+static inline uint32_t group_match_empty(const int8_t *ctrl) {
+    return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline uint32_t group_match_empty_or_deleted(const int8_t *ctrl) {
+    return wasm_i8x16_bitmask(wasm_v128_load(ctrl));
+}
+
+#else
+
+static inline uint32_t group_match(const int8_t *ctrl, int8_t h2) {
+    uint32_t mask = 0;
+    for (int i = 0; i < CAB_HASH_MAP_GROUP_SIZE; i++) {
+        mask |= (uint32_t)(ctrl[i] == h2) << i;
+    }
+    return mask;
+}
+
+static inline uint32_t group_match_empty(const int8_t *ctrl) {
+    return group_match(ctrl, CTRL_EMPTY);
+}
+
+static inline uint32_t group_match_empty_or_deleted(const int8_t *ctrl) {
+    uint32_t mask = 0;
+    for (int i = 0; i < CAB_HASH_MAP_GROUP_SIZE; i++) {
+        mask |= (uint32_t)(ctrl[i] < 0) << i;
+    }
+    return mask;
+}
+
+#endif
+
+static inline int lowest_bit(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return (int)index;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+// --- Table ---
+
+static inline size_t h1(uint64_t hash) {
+    return (size_t)(hash >> 7);
+}
+
+static inline int8_t h2(uint64_t hash) {
+    return (int8_t)(hash & 0x7f);
+}
+
+static inline char *entry_at(Cab_Hash_Map *map, size_t slot) {
+    return map->entries + slot * map->entry_size;
+}
+
+static inline size_t max_load(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+static bool allocate_table(Cab_Hash_Map *map, size_t capacity) {
+    Cab_Arena *arena = cab_arena_create_tagged(capacity + capacity * map->entry_size + 2 * CAB_ARENA_DEFAULT_ALIGNMENT, map->tag);
+    if (!arena) {
+        return false;
+    }
+    map->ctrl = cab_arena_alloc(arena, capacity);
+    map->entries = cab_arena_alloc(arena, capacity * map->entry_size);
+    memset(map->ctrl, CTRL_EMPTY, capacity);
+    map->arena = arena;
+    map->capacity = capacity;
+    map->growth_left = max_load(capacity);
+    return true;
+}
+
+Cab_Hash_Map *cab_hash_map_create(size_t key_size, size_t value_size, Cab_Hash_Func hash, Cab_Eq_Func eq, size_t initial_capacity) {
+    return cab_hash_map_create_tagged(key_size, value_size, hash, eq, initial_capacity, CAB_MEM_TAG_CONTAINERS);
+}
+
+Cab_Hash_Map *cab_hash_map_create_tagged(size_t key_size, size_t value_size, Cab_Hash_Func hash, Cab_Eq_Func eq, size_t initial_capacity, Cab_Mem_Tag tag) {
+    Cab_Hash_Map *map = (Cab_Hash_Map *)cab_malloc(tag, sizeof(Cab_Hash_Map));
+    if (!map) {
+        return NULL;
+    }
+    // Keys and values are padded to 8 bytes so both are suitably aligned for integer and pointer types
+    size_t value_offset = (key_size + 7) & ~(size_t)7;
+    *map = (Cab_Hash_Map){
+        .key_size = key_size,
+        .value_size = value_size,
+        .value_offset = value_offset,
+        .entry_size = (value_offset + value_size + 7) & ~(size_t)7,
+        .hash = hash,
+        .eq = eq,
+        .tag = tag,
+    };
+
+    size_t capacity = MIN_CAPACITY;
+    while (max_load(capacity) < initial_capacity) {
+        capacity *= 2;
+    }
+    if (!allocate_table(map, capacity)) {
+        cab_free(map);
+        return NULL;
+    }
+    return map;
+}
+
+void cab_hash_map_destroy(Cab_Hash_Map *map) {
+    if (!map) {
+        return;
+    }
+    cab_arena_destroy(map->arena);
+    cab_free(map);
+}
+
+// Groups are probed with triangular steps, which visits every group once for power of two group counts
+static bool find(Cab_Hash_Map *map, const void *key, uint64_t hash, size_t *slot) {
+    size_t group_mask = map->capacity / CAB_HASH_MAP_GROUP_SIZE - 1;
+    size_t group = h1(hash) & group_mask;
+    int8_t tag = h2(hash);
+    for (size_t step = 1;; step++) {
+        const int8_t *ctrl = map->ctrl + group * CAB_HASH_MAP_GROUP_SIZE;
+        for (uint32_t match = group_match(ctrl, tag); match; match &= match - 1) {
+            size_t candidate = group * CAB_HASH_MAP_GROUP_SIZE + lowest_bit(match);
+            if (map->eq(entry_at(map, candidate), key)) {
+                *slot = candidate;
+                return true;
+            }
+        }
+        if (group_match_empty(ctrl) || step > group_mask) {
+            return false;
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+static size_t find_insert_slot(Cab_Hash_Map *map, uint64_t hash) {
+    size_t group_mask = map->capacity / CAB_HASH_MAP_GROUP_SIZE - 1;
+    size_t group = h1(hash) & group_mask;
+    for (size_t step = 1;; step++) {
+        uint32_t match = group_match_empty_or_deleted(map->ctrl + group * CAB_HASH_MAP_GROUP_SIZE);
+        if (match) {
+            return group * CAB_HASH_MAP_GROUP_SIZE + lowest_bit(match);
+        }
+        group = (group + step) & group_mask;
+    }
+}
+
+// Rebuild the table, doubling it unless most of the used slots are tombstones
+static bool rehash(Cab_Hash_Map *map) {
+    size_t capacity = map->count * 2 >= max_load(map->capacity) ? map->capacity * 2 : map->capacity;
+    Cab_Hash_Map old = *map;
+    if (!allocate_table(map, capacity)) {
+        return false;
+    }
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.ctrl[i] >= 0) {
+            char *entry = old.entries + i * old.entry_size;
+            uint64_t hash = map->hash(entry);
+            size_t slot = find_insert_slot(map, hash);
+            map->ctrl[slot] = h2(hash);
+            memcpy(entry_at(map, slot), entry, map->entry_size);
+        }
+    }
+    map->growth_left -= map->count;
+    cab_arena_destroy(old.arena);
+    return true;
+}
+
+void *cab_hash_map_get(Cab_Hash_Map *map, const void *key) {
+    size_t slot;
+    if (!find(map, key, map->hash(key), &slot)) {
+        return NULL;
+    }
+    return entry_at(map, slot) + map->value_offset;
+}
+
+void *cab_hash_map_put(Cab_Hash_Map *map, const void *key, const void *value) {
+    uint64_t hash = map->hash(key);
+    size_t slot;
+    if (!find(map, key, hash, &slot)) {
+        slot = find_insert_slot(map, hash);
+        if (map->ctrl[slot] == CTRL_EMPTY && map->growth_left == 0) {
+            if (!rehash(map)) {
+                return NULL;
+            }
+            slot = find_insert_slot(map, hash);
+        }
+        if (map->ctrl[slot] == CTRL_EMPTY) {
+            map->growth_left--;
+        }
+        map->ctrl[slot] = h2(hash);
+        map->count++;
+        memcpy(entry_at(map, slot), key, map->key_size);
+    }
+
+    char *dst = entry_at(map, slot) + map->value_offset;
+    if (value) {
+        memcpy(dst, value, map->value_size);
+    } else {
+        memset(dst, 0, map->value_size);
+    }
+    return dst;
+}
+
+bool cab_hash_map_remove(Cab_Hash_Map *map, const void *key) {
+    size_t slot;
+    if (!find(map, key, map->hash(key), &slot)) {
+        return false;
+    }
+    // A probe only continues past a group without empty slots, so if this group already has one
+    // the slot can go straight back to empty instead of leaving a tombstone
+    const int8_t *ctrl = map->ctrl + (slot & ~(size_t)(CAB_HASH_MAP_GROUP_SIZE - 1));
+    if (group_match_empty(ctrl)) {
+        map->ctrl[slot] = CTRL_EMPTY;
+        map->growth_left++;
+    } else {
+        map->ctrl[slot] = CTRL_DELETED;
+    }
+    map->count--;
+    return true;
+}
+
+void cab_hash_map_clear(Cab_Hash_Map *map) {
+    memset(map->ctrl, CTRL_EMPTY, map->capacity);
+    map->count = 0;
+    map->growth_left = max_load(map->capacity);
+}
+
+bool cab_hash_map_next(Cab_Hash_Map *map, size_t *iter, void **key, void **value) {
+    for (size_t i = *iter; i < map->capacity; i++) {
+        if (map->ctrl[i] >= 0) {
+            *iter = i + 1;
+            *key = entry_at(map, i);
+            *value = entry_at(map, i) + map->value_offset;
+            return true;
+        }
+    }
+    *iter = map->capacity;
+    return false;
+}
+
+// --- Hash functions for the typed wrappers ---
+
+uint64_t cab_hash_u32(const void *key) {
+    return cab_hash_mix(*(const uint32_t *)key);
+}
+
+uint64_t cab_hash_u64(const void *key) {
+    return cab_hash_mix(*(const uint64_t *)key);
+}
+
+uint64_t cab_hash_sv(const void *key) {
+    const Cab_String_View *sv = (const Cab_String_View *)key;
+    return cab_hash_bytes(sv->data, sv->length);
+}
+
+bool cab_eq_u32(const void *a, const void *b) {
+    return *(const uint32_t *)a == *(const uint32_t *)b;
+}
+
+bool cab_eq_u64(const void *a, const void *b) {
+    return *(const uint64_t *)a == *(const uint64_t *)b;
+}
+
+bool cab_eq_sv(const void *a, const void *b) {
+    return cab_sv_eq(*(const Cab_String_View *)a, *(const Cab_String_View *)b);
+}
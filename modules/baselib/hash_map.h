@@ -0,0 +1,101 @@
+#ifndef CAB_HASH_MAP_H
+#define CAB_HASH_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "strings.h"
+
+// Open addressing hash map in the style of Swiss tables. Slots are split into groups of
+// CAB_HASH_MAP_GROUP_SIZE control bytes that are matched in one go with SSE2, NEON or wasm simd128.
+// Keys and values are copied into the table, so pointers returned by get/put are invalidated by the
+// next insert that grows the table.
+
+#define CAB_HASH_MAP_GROUP_SIZE 16
+
+typedef uint64_t (*Cab_Hash_Func)(const void *key);
+typedef bool (*Cab_Eq_Func)(const void *a, const void *b);
+
+typedef struct Cab_Hash_Map {
+    size_t count;          // Live entries
+    size_t capacity;       // Slots, a power of two and a multiple of CAB_HASH_MAP_GROUP_SIZE
+    size_t growth_left;    // Inserts into empty slots left before the table is rebuilt
+    size_t key_size;
+    size_t value_size;
+    size_t value_offset;   // Offset of the value inside an entry
+    size_t entry_size;
+    Cab_Hash_Func hash;
+    Cab_Eq_Func eq;
+    int8_t *ctrl;          // One control byte per slot: empty, deleted or the low 7 bits of the hash
+    char *entries;         // capacity entries of key followed by value
+    Cab_Arena *arena;      // Holds ctrl and entries, replaced whenever the table is rebuilt
+    Cab_Mem_Tag tag;       // Subsystem the map's memory is charged to
+} Cab_Hash_Map;
+
+// Maps from cab_hash_map_create are charged to CAB_MEM_TAG_CONTAINERS
+Cab_Hash_Map *cab_hash_map_create(size_t key_size, size_t value_size, Cab_Hash_Func hash, Cab_Eq_Func eq, size_t initial_capacity);
+Cab_Hash_Map *cab_hash_map_create_tagged(size_t key_size, size_t value_size, Cab_Hash_Func hash, Cab_Eq_Func eq, size_t initial_capacity, Cab_Mem_Tag tag);
+void cab_hash_map_destroy(Cab_Hash_Map *map);
+
+// Pointer to the value stored for key, or NULL
+void *cab_hash_map_get(Cab_Hash_Map *map, const void *key);
+// Insert or overwrite the value for key (zeroed if value is NULL). Returns the stored value, or NULL when out of memory
+void *cab_hash_map_put(Cab_Hash_Map *map, const void *key, const void *value);
+bool cab_hash_map_remove(Cab_Hash_Map *map, const void *key);
+void cab_hash_map_clear(Cab_Hash_Map *map);
+// Walk every entry. Start with *iter = 0, returns false once all entries have been visited
+bool cab_hash_map_next(Cab_Hash_Map *map, size_t *iter, void **key, void **value);
+
+// --- Hash functions ---
+
+static inline uint64_t cab_hash_mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+static inline uint64_t cab_hash_bytes(const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    uint64_t hash = 0xcbf29ce484222325ULL; // FNV-1a, mixed at the end so the low and high bits are both usable
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return cab_hash_mix(hash);
+}
+
+uint64_t cab_hash_u32(const void *key);
+uint64_t cab_hash_u64(const void *key);
+uint64_t cab_hash_sv(const void *key);
+bool cab_eq_u32(const void *a, const void *b);
+bool cab_eq_u64(const void *a, const void *b);
+bool cab_eq_sv(const void *a, const void *b);
+
+// --- Typed wrappers ---
+// CAB_HASH_MAP_DECLARE(Name, prefix, Key, Value, hash, eq) declares a struct Name wrapping a
+// Cab_Hash_Map together with prefix_create/destroy/get/put/remove functions that take keys and
+// values by value. String view keys only store the view, the bytes must outlive the map.
+
+#define CAB_HASH_MAP_DECLARE(Name, prefix, Key, Value, hash_func, eq_func)                                \
+    typedef struct Name {                                                                                 \
+        Cab_Hash_Map *map;                                                                                \
+    } Name;                                                                                               \
+    static inline Name prefix##_create(size_t initial_capacity) {                                         \
+        return (Name){cab_hash_map_create(sizeof(Key), sizeof(Value), hash_func, eq_func, initial_capacity)}; \
+    }                                                                                                     \
+    static inline void prefix##_destroy(Name m) { cab_hash_map_destroy(m.map); }                         \
+    static inline Value *prefix##_get(Name m, Key key) { return (Value *)cab_hash_map_get(m.map, &key); } \
+    static inline Value *prefix##_put(Name m, Key key, Value value) {                                     \
+        return (Value *)cab_hash_map_put(m.map, &key, &value);                                            \
+    }                                                                                                     \
+    static inline bool prefix##_remove(Name m, Key key) { return cab_hash_map_remove(m.map, &key); }
+
+#define CAB_HASH_MAP_U32(Name, prefix, Value) CAB_HASH_MAP_DECLARE(Name, prefix, uint32_t, Value, cab_hash_u32, cab_eq_u32)
+#define CAB_HASH_MAP_U64(Name, prefix, Value) CAB_HASH_MAP_DECLARE(Name, prefix, uint64_t, Value, cab_hash_u64, cab_eq_u64)
+#define CAB_HASH_MAP_SV(Name, prefix, Value) CAB_HASH_MAP_DECLARE(Name, prefix, Cab_String_View, Value, cab_hash_sv, cab_eq_sv)
+
+#endif // CAB_HASH_MAP_H
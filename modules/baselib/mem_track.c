@@ -0,0 +1,233 @@
+#include "mem_track.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+#if defined(CAB_SINGLE_THREADED)
+
+typedef size_t Counter;
+
+static inline size_t counter_load(Counter *counter) {
+    return *counter;
+}
+
+static inline void counter_store(Counter *counter, size_t value) {
+    *counter = value;
+}
+
+// Both return the new value
+static inline size_t counter_add(Counter *counter, size_t value) {
+    return *counter += value;
+}
+
+static inline size_t counter_sub(Counter *counter, size_t value) {
+    return *counter -= value;
+}
+
+static inline void counter_max(Counter *counter, size_t value) {
+    if (value > *counter) {
+        *counter = value;
+    }
+}
+
+#else
+
+#include <stdatomic.h>
+
+typedef atomic_size_t Counter;
+
+static inline size_t counter_load(Counter *counter) {
+    return atomic_load_explicit(counter, memory_order_relaxed);
+}
+
+static inline void counter_store(Counter *counter, size_t value) {
+    atomic_store_explicit(counter, value, memory_order_relaxed);
+}
+
+static inline size_t counter_add(Counter *counter, size_t value) {
+    return atomic_fetch_add_explicit(counter, value, memory_order_relaxed) + value;
+}
+
+static inline size_t counter_sub(Counter *counter, size_t value) {
+    return atomic_fetch_sub_explicit(counter, value, memory_order_relaxed) - value;
+}
+
+static inline void counter_max(Counter *counter, size_t value) {
+    size_t seen = atomic_load_explicit(counter, memory_order_relaxed);
+    while (value > seen && !atomic_compare_exchange_weak_explicit(counter, &seen, value, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+#endif
+
+typedef struct Tag_Counters {
+    Counter current;
+    Counter peak;
+    Counter allocations;
+    Counter total_allocations;
+    Counter budget;
+} Tag_Counters;
+
+static Tag_Counters tags[CAB_MEM_TAG_COUNT];
+
+static const char *tag_names[CAB_MEM_TAG_COUNT] = {
+    [CAB_MEM_TAG_UNTAGGED] = "untagged",
+    [CAB_MEM_TAG_ENGINE] = "engine",
+    [CAB_MEM_TAG_FRAME] = "frame",
+    [CAB_MEM_TAG_THREADS] = "threads",
+    [CAB_MEM_TAG_STRINGS] = "strings",
+    [CAB_MEM_TAG_CONTAINERS] = "containers",
+    [CAB_MEM_TAG_WORLD] = "world",
+    [CAB_MEM_TAG_MESH] = "mesh",
+    [CAB_MEM_TAG_TEXTURE] = "texture",
+    [CAB_MEM_TAG_AUDIO] = "audio",
+    [CAB_MEM_TAG_SCRIPT] = "script",
+    [CAB_MEM_TAG_GAME] = "game",
+};
+
+const char *cab_mem_tag_name(Cab_Mem_Tag tag) {
+    return tag < CAB_MEM_TAG_COUNT ? tag_names[tag] : "invalid";
+}
+
+Cab_Mem_Tag_Stats cab_mem_tag_stats(Cab_Mem_Tag tag) {
+    Tag_Counters *counters = &tags[tag];
+    return (Cab_Mem_Tag_Stats){
+        .current = counter_load(&counters->current),
+        .peak = counter_load(&counters->peak),
+        .allocations = counter_load(&counters->allocations),
+        .total_allocations = counter_load(&counters->total_allocations),
+        .budget = counter_load(&counters->budget),
+    };
+}
+
+void cab_mem_set_budget(Cab_Mem_Tag tag, size_t budget) {
+    counter_store(&tags[tag].budget, budget);
+}
+
+void cab_mem_reset_peaks() {
+    for (int i = 0; i < CAB_MEM_TAG_COUNT; i++) {
+        counter_store(&tags[i].peak, counter_load(&tags[i].current));
+    }
+}
+
+void cab_mem_write_csv_header(FILE *file) {
+    fprintf(file, "frame,tag,current,peak,allocations,total_allocations,budget\n");
+}
+
+void cab_mem_write_csv(FILE *file, uint64_t frame) {
+    for (int i = 0; i < CAB_MEM_TAG_COUNT; i++) {
+        Cab_Mem_Tag_Stats stats = cab_mem_tag_stats((Cab_Mem_Tag)i);
+        fprintf(file, "%llu,%s,%zu,%zu,%zu,%zu,%zu\n", (unsigned long long)frame, tag_names[i], stats.current,
+                stats.peak, stats.allocations, stats.total_allocations, stats.budget);
+    }
+}
+
+// Report only when current crosses the budget, not on every allocation above it
+static void grew(Cab_Mem_Tag tag, size_t size, size_t current) {
+    Tag_Counters *counters = &tags[tag];
+    counter_max(&counters->peak, current);
+    size_t budget = counter_load(&counters->budget);
+    if (budget != 0 && current > budget && current - size <= budget) {
+        fprintf(stderr, "[WARNING] Memory budget for '%s' exceeded: %zu of %zu bytes\n", tag_names[tag], current, budget);
+#if defined(CAB_MEM_BUDGET_ASSERT)
+        assert(!"memory budget exceeded");
+#endif
+    }
+}
+
+void cab_mem_track_alloc(Cab_Mem_Tag tag, size_t size) {
+    Tag_Counters *counters = &tags[tag];
+    counter_add(&counters->allocations, 1);
+    counter_add(&counters->total_allocations, 1);
+    grew(tag, size, counter_add(&counters->current, size));
+}
+
+void cab_mem_track_free(Cab_Mem_Tag tag, size_t size) {
+    Tag_Counters *counters = &tags[tag];
+    counter_sub(&counters->allocations, 1);
+    counter_sub(&counters->current, size);
+}
+
+void cab_mem_track_retag(Cab_Mem_Tag from, Cab_Mem_Tag to, size_t size) {
+    if (from == to) {
+        return;
+    }
+    // The allocation already exists, so it moves between the live counts without adding to the totals
+    counter_sub(&tags[from].allocations, 1);
+    counter_sub(&tags[from].current, size);
+    counter_add(&tags[to].allocations, 1);
+    grew(to, size, counter_add(&tags[to].current, size));
+}
+
+void cab_mem_track_resize(Cab_Mem_Tag tag, size_t old_size, size_t new_size) {
+    Tag_Counters *counters = &tags[tag];
+    if (new_size > old_size) {
+        grew(tag, new_size - old_size, counter_add(&counters->current, new_size - old_size));
+    } else {
+        counter_sub(&counters->current, old_size - new_size);
+    }
+}
+
+// --- Tagged malloc ---
+// Every block is prefixed with its size and tag, padded so the user pointer keeps malloc's alignment
+
+typedef union Malloc_Header {
+    struct {
+        size_t size;
+        Cab_Mem_Tag tag;
+    };
+    max_align_t align;
+} Malloc_Header;
+
+void *cab_malloc(Cab_Mem_Tag tag, size_t size) {
+    if (size > SIZE_MAX - sizeof(Malloc_Header)) {
+        return NULL;
+    }
+    Malloc_Header *header = (Malloc_Header *)malloc(sizeof(Malloc_Header) + size);
+    if (!header) {
+        return NULL;
+    }
+    header->size = size;
+    header->tag = tag;
+    cab_mem_track_alloc(tag, size);
+    return header + 1;
+}
+
+void *cab_calloc(Cab_Mem_Tag tag, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) {
+        return NULL;
+    }
+    void *ptr = cab_malloc(tag, count * size);
+    if (ptr) {
+        memset(ptr, 0, count * size);
+    }
+    return ptr;
+}
+
+void *cab_realloc(void *ptr, size_t size) {
+    if (!ptr) {
+        return cab_malloc(CAB_MEM_TAG_UNTAGGED, size);
+    }
+    if (size > SIZE_MAX - sizeof(Malloc_Header)) {
+        return NULL;
+    }
+    Malloc_Header *header = (Malloc_Header *)ptr - 1;
+    size_t old_size = header->size;
+    header = (Malloc_Header *)realloc(header, sizeof(Malloc_Header) + size);
+    if (!header) {
+        return NULL;
+    }
+    header->size = size;
+    cab_mem_track_resize(header->tag, old_size, size);
+    return header + 1;
+}
+
+void cab_free(void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    Malloc_Header *header = (Malloc_Header *)ptr - 1;
+    cab_mem_track_free(header->tag, header->size);
+    free(header);
+}
@@ -0,0 +1,67 @@
+#ifndef CAB_MEM_TRACK_H
+#define CAB_MEM_TRACK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Memory accounting per subsystem. Arenas (and everything built on them) and the cab_malloc
+// wrappers charge the backing memory they hold to a tag, so current and peak usage plus the
+// number of live backing allocations can be read per subsystem. A tag can be given a budget:
+// going over it logs to stderr, and asserts too when CAB_MEM_BUDGET_ASSERT is defined.
+
+typedef enum Cab_Mem_Tag {
+    CAB_MEM_TAG_UNTAGGED,
+    CAB_MEM_TAG_ENGINE,
+    CAB_MEM_TAG_FRAME,
+    CAB_MEM_TAG_THREADS,
+    CAB_MEM_TAG_STRINGS,
+    CAB_MEM_TAG_CONTAINERS,
+    CAB_MEM_TAG_WORLD,
+    CAB_MEM_TAG_MESH,
+    CAB_MEM_TAG_TEXTURE,
+    CAB_MEM_TAG_AUDIO,
+    CAB_MEM_TAG_SCRIPT,
+    CAB_MEM_TAG_GAME,
+    CAB_MEM_TAG_COUNT
+} Cab_Mem_Tag;
+
+typedef struct Cab_Mem_Tag_Stats {
+    size_t current;     // Bytes held right now
+    size_t peak;        // Largest value current has reached
+    size_t allocations; // Live backing allocations (arena blocks, malloc calls)
+    size_t total_allocations; // Backing allocations ever made
+    size_t budget;      // 0 when the tag has no budget
+} Cab_Mem_Tag_Stats;
+
+const char *cab_mem_tag_name(Cab_Mem_Tag tag);
+Cab_Mem_Tag_Stats cab_mem_tag_stats(Cab_Mem_Tag tag);
+// Set to 0 to remove the budget
+void cab_mem_set_budget(Cab_Mem_Tag tag, size_t budget);
+void cab_mem_reset_peaks();
+
+// Write "frame,tag,current,peak,allocations,total_allocations,budget" rows, one per tag.
+// Dumping every frame or every few seconds shows how memory grows over a long session
+void cab_mem_write_csv_header(FILE *file);
+void cab_mem_write_csv(FILE *file, uint64_t frame);
+
+// --- Accounting hooks used by the allocators ---
+
+// A new backing allocation of size bytes
+void cab_mem_track_alloc(Cab_Mem_Tag tag, size_t size);
+// A backing allocation of size bytes went away
+void cab_mem_track_free(Cab_Mem_Tag tag, size_t size);
+// Move a live backing allocation of size bytes from one tag to another
+void cab_mem_track_retag(Cab_Mem_Tag from, Cab_Mem_Tag to, size_t size);
+// An existing backing allocation changed size, e.g. pages committed or decommitted
+void cab_mem_track_resize(Cab_Mem_Tag tag, size_t old_size, size_t new_size);
+
+// --- Tagged malloc ---
+
+void *cab_malloc(Cab_Mem_Tag tag, size_t size);
+void *cab_calloc(Cab_Mem_Tag tag, size_t count, size_t size);
+void *cab_realloc(void *ptr, size_t size);
+void cab_free(void *ptr);
+
+#endif // CAB_MEM_TRACK_H
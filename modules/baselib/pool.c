@@ -0,0 +1,89 @@
+#include "pool.h"
+#include <stdint.h>
+
+Cab_Pool *cab_pool_create(size_t slot_size, size_t alignment, size_t slots_per_block) {
+    if (alignment == 0) {
+        alignment = CAB_ARENA_DEFAULT_ALIGNMENT;
+    }
+    if ((alignment & (alignment - 1)) != 0) {
+        return NULL;
+    }
+    if (slots_per_block == 0) {
+        slots_per_block = CAB_POOL_DEFAULT_SLOTS_PER_BLOCK;
+    }
+    if (slot_size < sizeof(Cab_Pool_Slot)) {
+        slot_size = sizeof(Cab_Pool_Slot);
+    }
+    if (slot_size > (SIZE_MAX - alignment) / slots_per_block) {
+        return NULL;
+    }
+    slot_size = (slot_size + alignment - 1) & ~(alignment - 1);
+
+    // One block holds the pool header and a full set of slots, including worst case alignment padding
+    Cab_Arena *arena = cab_arena_create_growable_tagged(sizeof(Cab_Pool) + slot_size * slots_per_block + alignment, CAB_MEM_TAG_CONTAINERS);
+    if (!arena) {
+        return NULL;
+    }
+    Cab_Pool *pool = cab_arena_alloc(arena, sizeof(Cab_Pool));
+    *pool = (Cab_Pool){
+        .slot_size = slot_size,
+        .alignment = alignment,
+        .slots_per_block = slots_per_block,
+        .arena = arena,
+        .base = cab_arena_mark(arena),
+    };
+    return pool;
+}
+
+void cab_pool_destroy(Cab_Pool *pool) {
+    if (!pool) {
+        return;
+    }
+    cab_arena_destroy(pool->arena);
+}
+
+void *cab_pool_alloc(Cab_Pool *pool) {
+    void *slot;
+    if (pool->free_list) {
+        slot = pool->free_list;
+        pool->free_list = pool->free_list->next;
+    } else {
+        if (pool->block_remaining == 0) {
+            pool->block_cursor = cab_arena_alloc_aligned(pool->arena, pool->slot_size * pool->slots_per_block, pool->alignment);
+            if (!pool->block_cursor) {
+                return NULL;
+            }
+            pool->block_remaining = pool->slots_per_block;
+            pool->capacity += pool->slots_per_block;
+        }
+        slot = pool->block_cursor;
+        pool->block_cursor += pool->slot_size;
+        pool->block_remaining--;
+    }
+
+    pool->count++;
+    if (pool->count > pool->high_water) {
+        pool->high_water = pool->count;
+    }
+    return slot;
+}
+
+void cab_pool_free(Cab_Pool *pool, void *ptr) {
+    if (!ptr) {
+        return;
+    }
+    Cab_Pool_Slot *slot = (Cab_Pool_Slot *)ptr;
+    slot->next = pool->free_list;
+    pool->free_list = slot;
+    pool->count--;
+}
+
+void cab_pool_reset(Cab_Pool *pool) {
+    cab_arena_rewind(pool->arena, pool->base);
+    pool->free_list = NULL;
+    pool->block_cursor = NULL;
+    pool->block_remaining = 0;
+    pool->count = 0;
+    pool->capacity = 0;
+    pool->high_water = 0;
+}
@@ -0,0 +1,39 @@
+#ifndef CAB_POOL_H
+#define CAB_POOL_H
+
+#include <stddef.h>
+#include "arena.h"
+
+#define CAB_POOL_DEFAULT_SLOTS_PER_BLOCK 256
+
+typedef struct Cab_Pool_Slot {
+    struct Cab_Pool_Slot *next;
+} Cab_Pool_Slot;
+
+typedef struct Cab_Pool {
+    size_t count;            // Slots currently in use
+    size_t capacity;         // Slots carved from the arena so far
+    size_t high_water;       // Largest number of slots in use at once since creation or reset
+    size_t slot_size;        // Bytes per slot, rounded up to the alignment
+    size_t alignment;        // Alignment of every slot
+    size_t slots_per_block;  // Slots carved from the arena at a time
+    Cab_Pool_Slot *free_list; // Released slots, linked through their own memory
+    char *block_cursor;      // Next uncarved slot in the current block
+    size_t block_remaining;  // Uncarved slots left in the current block
+    Cab_Arena *arena;        // Growable arena owned by the pool
+    Cab_Arena_Mark base;     // Arena position right after the pool itself
+} Cab_Pool;
+
+// Create a pool of slot_size byte slots. An alignment of 0 uses CAB_ARENA_DEFAULT_ALIGNMENT,
+// CAB_CACHE_LINE_SIZE keeps every slot on its own cache lines. The arena is tagged
+// CAB_MEM_TAG_CONTAINERS, cab_arena_set_tag(pool->arena, tag) charges it elsewhere
+Cab_Pool *cab_pool_create(size_t slot_size, size_t alignment, size_t slots_per_block);
+void cab_pool_destroy(Cab_Pool *pool);
+
+void *cab_pool_alloc(Cab_Pool *pool);
+void cab_pool_free(Cab_Pool *pool, void *ptr);
+
+// Release every slot at once and hand the arena blocks back for reuse
+void cab_pool_reset(Cab_Pool *pool);
+
+#endif // CAB_POOL_H
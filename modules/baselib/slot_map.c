@@ -0,0 +1,125 @@
+#include "slot_map.h"
+#include <string.h>
+
+#define SLOT_NONE UINT32_MAX
+
+Cab_Slot_Map *cab_slot_map_create(size_t item_size, uint32_t capacity) {
+    if (item_size == 0 || capacity == 0 || capacity == SLOT_NONE) {
+        return NULL;
+    }
+    if (item_size > (SIZE_MAX / 2) / capacity) {
+        return NULL;
+    }
+    size_t arena_size = sizeof(Cab_Slot_Map) + item_size * capacity + sizeof(uint32_t) * capacity +
+                        sizeof(Cab_Slot_Map_Slot) * capacity + 4 * CAB_ARENA_DEFAULT_ALIGNMENT;
+    Cab_Arena *arena = cab_arena_create_tagged(arena_size, CAB_MEM_TAG_CONTAINERS);
+    if (!arena) {
+        return NULL;
+    }
+    Cab_Slot_Map *map = cab_arena_alloc(arena, sizeof(Cab_Slot_Map));
+    map->capacity = capacity;
+    map->item_size = item_size;
+    map->items = cab_arena_alloc(arena, item_size * capacity);
+    map->item_slots = cab_arena_alloc(arena, sizeof(uint32_t) * capacity);
+    map->slots = cab_arena_alloc(arena, sizeof(Cab_Slot_Map_Slot) * capacity);
+    map->arena = arena;
+    for (uint32_t i = 0; i < capacity; i++) {
+        map->slots[i].generation = 2;
+    }
+    cab_slot_map_clear(map);
+    return map;
+}
+
+void cab_slot_map_destroy(Cab_Slot_Map *map) {
+    if (!map) {
+        return;
+    }
+    cab_arena_destroy(map->arena);
+}
+
+Cab_Handle cab_slot_map_insert(Cab_Slot_Map *map, const void *item) {
+    if (map->free_head == SLOT_NONE) {
+        return CAB_HANDLE_NULL;
+    }
+    uint32_t index = map->free_head;
+    Cab_Slot_Map_Slot *slot = &map->slots[index];
+    map->free_head = slot->item;
+
+    uint32_t dense = map->count++;
+    void *dst = (char *)map->items + dense * map->item_size;
+    if (item) {
+        memcpy(dst, item, map->item_size);
+    } else {
+        memset(dst, 0, map->item_size);
+    }
+    map->item_slots[dense] = index;
+    slot->item = dense;
+    slot->generation++; // even -> odd, marks the slot as used
+    return (Cab_Handle){index, slot->generation};
+}
+
+static Cab_Slot_Map_Slot *lookup(Cab_Slot_Map *map, Cab_Handle handle) {
+    if (handle.index >= map->capacity) {
+        return NULL;
+    }
+    Cab_Slot_Map_Slot *slot = &map->slots[handle.index];
+    if (slot->generation != handle.generation || (slot->generation & 1) == 0) {
+        return NULL;
+    }
+    return slot;
+}
+
+void *cab_slot_map_get(Cab_Slot_Map *map, Cab_Handle handle) {
+    Cab_Slot_Map_Slot *slot = lookup(map, handle);
+    if (!slot) {
+        return NULL;
+    }
+    return (char *)map->items + slot->item * map->item_size;
+}
+
+bool cab_slot_map_remove(Cab_Slot_Map *map, Cab_Handle handle) {
+    Cab_Slot_Map_Slot *slot = lookup(map, handle);
+    if (!slot) {
+        return false;
+    }
+    uint32_t dense = slot->item;
+    uint32_t last = --map->count;
+    if (dense != last) {
+        memcpy((char *)map->items + dense * map->item_size, (char *)map->items + last * map->item_size, map->item_size);
+        uint32_t moved = map->item_slots[last];
+        map->item_slots[dense] = moved;
+        map->slots[moved].item = dense;
+    }
+
+    // odd -> even marks the slot as free, skipping 0 so a null handle never matches
+    slot->generation++;
+    if (slot->generation == 0) {
+        slot->generation = 2;
+    }
+    slot->item = map->free_head;
+    map->free_head = handle.index;
+    return true;
+}
+
+Cab_Handle cab_slot_map_handle_at(Cab_Slot_Map *map, uint32_t item) {
+    if (item >= map->count) {
+        return CAB_HANDLE_NULL;
+    }
+    uint32_t index = map->item_slots[item];
+    return (Cab_Handle){index, map->slots[index].generation};
+}
+
+void cab_slot_map_clear(Cab_Slot_Map *map) {
+    for (uint32_t i = 0; i < map->capacity; i++) {
+        Cab_Slot_Map_Slot *slot = &map->slots[i];
+        if (slot->generation & 1) {
+            slot->generation++;
+            if (slot->generation == 0) {
+                slot->generation = 2;
+            }
+        }
+        slot->item = i + 1 < map->capacity ? i + 1 : SLOT_NONE;
+    }
+    map->free_head = 0;
+    map->count = 0;
+}
@@ -0,0 +1,55 @@
+#ifndef CAB_SLOT_MAP_H
+#define CAB_SLOT_MAP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+// Reference to an item in a slot map. The generation changes every time a slot is reused,
+// so handles to removed items stop resolving instead of pointing at whatever replaced them
+typedef struct Cab_Handle {
+    uint32_t index;
+    uint32_t generation;
+} Cab_Handle;
+
+#define CAB_HANDLE_NULL ((Cab_Handle){0, 0})
+
+typedef struct Cab_Slot_Map_Slot {
+    uint32_t item;       // Dense index of the item, or the next free slot while unused
+    uint32_t generation; // Odd while the slot is in use, never 0
+} Cab_Slot_Map_Slot;
+
+typedef struct Cab_Slot_Map {
+    uint32_t count;           // Live items, stored packed at the front of items
+    uint32_t capacity;        // Maximum number of live items
+    size_t item_size;
+    void *items;              // Dense array of count items, safe to iterate linearly
+    uint32_t *item_slots;     // Slot owning each dense item
+    Cab_Slot_Map_Slot *slots; // Sparse slots that handles point at
+    uint32_t free_head;       // First unused slot
+    Cab_Arena *arena;         // Fixed arena holding the map and its arrays
+} Cab_Slot_Map;
+
+Cab_Slot_Map *cab_slot_map_create(size_t item_size, uint32_t capacity);
+void cab_slot_map_destroy(Cab_Slot_Map *map);
+
+// Copy item into the map (zero it if item is NULL). Returns CAB_HANDLE_NULL when the map is full
+Cab_Handle cab_slot_map_insert(Cab_Slot_Map *map, const void *item);
+// Returns NULL for stale or null handles. The pointer is invalidated by the next remove
+void *cab_slot_map_get(Cab_Slot_Map *map, Cab_Handle handle);
+// Swap the last item into the hole so items stays packed. Returns false for stale handles
+bool cab_slot_map_remove(Cab_Slot_Map *map, Cab_Handle handle);
+// Handle of the item at a dense index, for use while iterating items
+Cab_Handle cab_slot_map_handle_at(Cab_Slot_Map *map, uint32_t item);
+void cab_slot_map_clear(Cab_Slot_Map *map);
+
+static inline bool cab_handle_is_null(Cab_Handle handle) {
+    return handle.generation == 0;
+}
+
+static inline bool cab_slot_map_contains(Cab_Slot_Map *map, Cab_Handle handle) {
+    return cab_slot_map_get(map, handle) != NULL;
+}
+
+#endif // CAB_SLOT_MAP_H
@@ -0,0 +1,223 @@
+#include "strings.h"
+#include <ctype.h>
+#include <stdio.h>
+#include "hash_map.h"
+
+// --- String views ---
+
+Cab_String_View cab_sv_chop_by_delim(Cab_String_View *sv, char delim) {
+    size_t i = 0;
+    while (i < sv->length && sv->data[i] != delim) {
+        i++;
+    }
+    Cab_String_View result = {sv->data, i};
+    if (i < sv->length) {
+        i++; // Skip the delimiter
+    }
+    sv->data += i;
+    sv->length -= i;
+    return result;
+}
+
+Cab_String_View cab_sv_trim(Cab_String_View sv) {
+    while (sv.length > 0 && isspace((unsigned char)sv.data[0])) {
+        sv.data++;
+        sv.length--;
+    }
+    while (sv.length > 0 && isspace((unsigned char)sv.data[sv.length - 1])) {
+        sv.length--;
+    }
+    return sv;
+}
+
+Cab_String_View cab_sv_copy(Cab_Arena *arena, Cab_String_View sv) {
+    char *data = cab_arena_alloc_aligned(arena, sv.length + 1, 1);
+    if (!data) {
+        return (Cab_String_View){0};
+    }
+    if (sv.length > 0) {
+        memcpy(data, sv.data, sv.length);
+    }
+    data[sv.length] = '\0';
+    return (Cab_String_View){data, sv.length};
+}
+
+Cab_String_View cab_sv_vprintf(Cab_Arena *arena, const char *fmt, va_list args) {
+    va_list measure;
+    va_copy(measure, args);
+    int length = vsnprintf(NULL, 0, fmt, measure);
+    va_end(measure);
+    if (length < 0) {
+        return (Cab_String_View){0};
+    }
+    char *data = cab_arena_alloc_aligned(arena, (size_t)length + 1, 1);
+    if (!data) {
+        return (Cab_String_View){0};
+    }
+    vsnprintf(data, (size_t)length + 1, fmt, args);
+    return (Cab_String_View){data, (size_t)length};
+}
+
+Cab_String_View cab_sv_printf(Cab_Arena *arena, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    Cab_String_View result = cab_sv_vprintf(arena, fmt, args);
+    va_end(args);
+    return result;
+}
+
+// --- String builder ---
+
+Cab_String_Builder cab_sb_create(Cab_Arena *arena, size_t initial_capacity) {
+    if (initial_capacity == 0) {
+        initial_capacity = 64;
+    }
+    Cab_String_Builder sb = {.arena = arena};
+    sb.data = cab_arena_alloc_aligned(arena, initial_capacity, 1);
+    if (sb.data) {
+        sb.data[0] = '\0';
+        sb.capacity = initial_capacity;
+    }
+    return sb;
+}
+
+// Make room for extra bytes plus the NUL terminator
+static bool sb_reserve(Cab_String_Builder *sb, size_t extra) {
+    if (sb->length + extra < sb->capacity) {
+        return true;
+    }
+    size_t capacity = sb->capacity ? sb->capacity : 64;
+    while (sb->length + extra >= capacity) {
+        capacity *= 2;
+    }
+    char *data = cab_arena_alloc_aligned(sb->arena, capacity, 1);
+    if (!data) {
+        return false;
+    }
+    if (sb->length > 0) {
+        memcpy(data, sb->data, sb->length);
+    }
+    sb->data = data;
+    sb->capacity = capacity;
+    return true;
+}
+
+void cab_sb_append_sv(Cab_String_Builder *sb, Cab_String_View sv) {
+    if (!sb_reserve(sb, sv.length)) {
+        return;
+    }
+    if (sv.length > 0) {
+        memcpy(sb->data + sb->length, sv.data, sv.length);
+    }
+    sb->length += sv.length;
+    sb->data[sb->length] = '\0';
+}
+
+void cab_sb_append_cstr(Cab_String_Builder *sb, const char *cstr) {
+    cab_sb_append_sv(sb, cab_sv_from_cstr(cstr));
+}
+
+void cab_sb_appendf(Cab_String_Builder *sb, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    va_list measure;
+    va_copy(measure, args);
+    int length = vsnprintf(NULL, 0, fmt, measure);
+    va_end(measure);
+    if (length >= 0 && sb_reserve(sb, (size_t)length)) {
+        vsnprintf(sb->data + sb->length, (size_t)length + 1, fmt, args);
+        sb->length += (size_t)length;
+    }
+    va_end(args);
+}
+
+Cab_String_View cab_sb_to_sv(Cab_String_Builder *sb) {
+    return (Cab_String_View){sb->data, sb->length};
+}
+
+// --- Interning ---
+
+#define INTERN_BYTES_BLOCK_SIZE (16 * 1024)
+
+// The hash is stored next to the view, so rehashing the id map never touches the string bytes again
+static uint64_t interned_hash(const void *key) {
+    return ((const Cab_Interned_String *)key)->hash;
+}
+
+static bool interned_eq(const void *a, const void *b) {
+    const Cab_Interned_String *x = (const Cab_Interned_String *)a;
+    const Cab_Interned_String *y = (const Cab_Interned_String *)b;
+    return x->hash == y->hash && cab_sv_eq(x->sv, y->sv);
+}
+
+static bool intern_grow(Cab_Intern_Table *table, uint32_t capacity) {
+    Cab_Arena *arena = cab_arena_create_tagged(sizeof(Cab_Interned_String) * capacity, CAB_MEM_TAG_STRINGS);
+    if (!arena) {
+        return false;
+    }
+    Cab_Interned_String *strings = cab_arena_alloc(arena, sizeof(Cab_Interned_String) * capacity);
+    if (table->count > 0) {
+        memcpy(strings, table->strings, sizeof(Cab_Interned_String) * table->count);
+    }
+    cab_arena_destroy(table->arena);
+    table->arena = arena;
+    table->strings = strings;
+    table->capacity = capacity;
+    return true;
+}
+
+Cab_Intern_Table *cab_intern_create(uint32_t initial_capacity) {
+    if (initial_capacity == 0) {
+        initial_capacity = 64;
+    }
+    Cab_Arena *bytes = cab_arena_create_growable_tagged(INTERN_BYTES_BLOCK_SIZE, CAB_MEM_TAG_STRINGS);
+    if (!bytes) {
+        return NULL;
+    }
+    Cab_Intern_Table *table = cab_arena_alloc(bytes, sizeof(Cab_Intern_Table));
+    *table = (Cab_Intern_Table){.bytes = bytes};
+    table->ids = cab_hash_map_create_tagged(sizeof(Cab_Interned_String), sizeof(Cab_String_Id), interned_hash, interned_eq,
+                                            initial_capacity, CAB_MEM_TAG_STRINGS);
+    if (!table->ids || !intern_grow(table, initial_capacity)) {
+        cab_intern_destroy(table);
+        return NULL;
+    }
+    return table;
+}
+
+void cab_intern_destroy(Cab_Intern_Table *table) {
+    if (!table) {
+        return;
+    }
+    cab_hash_map_destroy(table->ids);
+    cab_arena_destroy(table->arena);
+    cab_arena_destroy(table->bytes);
+}
+
+Cab_String_Id cab_intern_find(Cab_Intern_Table *table, Cab_String_View sv) {
+    Cab_Interned_String key = {sv, cab_hash_bytes(sv.data, sv.length)};
+    Cab_String_Id *id = cab_hash_map_get(table->ids, &key);
+    return id ? *id : CAB_STRING_ID_NONE;
+}
+
+Cab_String_Id cab_intern(Cab_Intern_Table *table, Cab_String_View sv) {
+    Cab_Interned_String key = {sv, cab_hash_bytes(sv.data, sv.length)};
+    Cab_String_Id *id = cab_hash_map_get(table->ids, &key);
+    if (id) {
+        return *id;
+    }
+
+    if (table->count == table->capacity && !intern_grow(table, table->capacity * 2)) {
+        return CAB_STRING_ID_NONE;
+    }
+    key.sv = cab_sv_copy(table->bytes, sv);
+    if (!key.sv.data) {
+        return CAB_STRING_ID_NONE;
+    }
+    Cab_String_Id new_id = table->count + 1;
+    if (!cab_hash_map_put(table->ids, &key, &new_id)) {
+        return CAB_STRING_ID_NONE;
+    }
+    table->strings[table->count++] = key;
+    return new_id;
+}
@@ -1,4 +1,110 @@
 #ifndef STRINGS_H
 #define STRINGS_H
 
-#endif // STRINGS_H 
+#include <assert.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "arena.h"
+
+// --- String views ---
+
+// Non-owning view of length bytes, not necessarily NUL terminated
+typedef struct Cab_String_View {
+    const char *data;
+    size_t length;
+} Cab_String_View;
+
+#define CAB_SV(literal) ((Cab_String_View){(literal), sizeof(literal) - 1})
+#define CAB_SV_FMT "%.*s"
+#define CAB_SV_ARG(sv) (int)(sv).length, (sv).data
+
+static inline Cab_String_View cab_sv_from_cstr(const char *cstr) {
+    return (Cab_String_View){cstr, strlen(cstr)};
+}
+
+static inline bool cab_sv_eq(Cab_String_View a, Cab_String_View b) {
+    return a.length == b.length && (a.length == 0 || memcmp(a.data, b.data, a.length) == 0);
+}
+
+static inline bool cab_sv_starts_with(Cab_String_View sv, Cab_String_View prefix) {
+    return sv.length >= prefix.length && cab_sv_eq((Cab_String_View){sv.data, prefix.length}, prefix);
+}
+
+static inline bool cab_sv_ends_with(Cab_String_View sv, Cab_String_View suffix) {
+    return sv.length >= suffix.length &&
+           cab_sv_eq((Cab_String_View){sv.data + sv.length - suffix.length, suffix.length}, suffix);
+}
+
+// Split off everything up to the first delim, removing it and the delimiter from sv
+Cab_String_View cab_sv_chop_by_delim(Cab_String_View *sv, char delim);
+Cab_String_View cab_sv_trim(Cab_String_View sv);
+
+// Copy the view into the arena, NUL terminated
+Cab_String_View cab_sv_copy(Cab_Arena *arena, Cab_String_View sv);
+// Format into the arena, NUL terminated
+Cab_String_View cab_sv_printf(Cab_Arena *arena, const char *fmt, ...);
+Cab_String_View cab_sv_vprintf(Cab_Arena *arena, const char *fmt, va_list args);
+
+// --- String builder ---
+
+// Appends into arena memory, moving to a buffer twice the size when it runs out of room
+typedef struct Cab_String_Builder {
+    char *data;
+    size_t length;
+    size_t capacity;
+    Cab_Arena *arena;
+} Cab_String_Builder;
+
+Cab_String_Builder cab_sb_create(Cab_Arena *arena, size_t initial_capacity);
+void cab_sb_append_sv(Cab_String_Builder *sb, Cab_String_View sv);
+void cab_sb_append_cstr(Cab_String_Builder *sb, const char *cstr);
+void cab_sb_appendf(Cab_String_Builder *sb, const char *fmt, ...);
+// View of the built string. The data stays NUL terminated
+Cab_String_View cab_sb_to_sv(Cab_String_Builder *sb);
+
+// --- Interning ---
+// Maps strings to stable 32-bit ids so hot paths can compare names as integers.
+// Interned bytes are copied into the table and stay valid until it is destroyed.
+
+typedef uint32_t Cab_String_Id;
+
+#define CAB_STRING_ID_NONE 0
+
+typedef struct Cab_Interned_String {
+    Cab_String_View sv; // NUL terminated copy owned by the table
+    uint64_t hash;      // cab_hash_bytes of the string, computed once
+} Cab_Interned_String;
+
+typedef struct Cab_Intern_Table {
+    uint32_t count;                // Interned strings, ids run from 1 to count
+    uint32_t capacity;
+    Cab_Interned_String *strings;  // Indexed by id - 1
+    struct Cab_Hash_Map *ids;      // Cab_Interned_String -> Cab_String_Id
+    Cab_Arena *bytes;              // Growable arena holding the string bytes
+    Cab_Arena *arena;              // Holds strings, replaced whenever it grows
+} Cab_Intern_Table;
+
+Cab_Intern_Table *cab_intern_create(uint32_t initial_capacity);
+void cab_intern_destroy(Cab_Intern_Table *table);
+
+// Id of the string, interning it first if needed. Returns CAB_STRING_ID_NONE when out of memory
+Cab_String_Id cab_intern(Cab_Intern_Table *table, Cab_String_View sv);
+// Id of an already interned string, or CAB_STRING_ID_NONE
+Cab_String_Id cab_intern_find(Cab_Intern_Table *table, Cab_String_View sv);
+
+// String and hash of an id returned by cab_intern or cab_intern_find. CAB_STRING_ID_NONE is
+// not a valid id, check for it first
+static inline Cab_String_View cab_intern_string(Cab_Intern_Table *table, Cab_String_Id id) {
+    assert(id != CAB_STRING_ID_NONE && id <= table->count);
+    return table->strings[id - 1].sv;
+}
+
+static inline uint64_t cab_intern_hash(Cab_Intern_Table *table, Cab_String_Id id) {
+    assert(id != CAB_STRING_ID_NONE && id <= table->count);
+    return table->strings[id - 1].hash;
+}
+
+#endif // STRINGS_H
@@ -0,0 +1,168 @@
+#include "thread_arena.h"
+
+#if !defined(CAB_SINGLE_THREADED)
+#include <stdatomic.h>
+#if defined(_MSC_VER)
+#define CAB_THREAD_LOCAL __declspec(thread)
+#else
+#define CAB_THREAD_LOCAL _Thread_local
+#endif
+#endif
+
+// Each slot is written by its own thread only, so it gets its own cache lines to avoid false sharing
+typedef struct Thread_Slot {
+    _Alignas(CAB_CACHE_LINE_SIZE) Cab_Arena *arena;
+    Cab_Thread_Result *results;      // First published result
+    Cab_Thread_Result *last_result;  // Last published result, new ones are appended here
+    size_t peak_size;                // Largest arena size seen at a sync point
+} Thread_Slot;
+
+static struct {
+    Thread_Slot slots[CAB_MAX_THREADS];
+    size_t block_size;
+#if defined(CAB_SINGLE_THREADED)
+    uint32_t count;
+#else
+    atomic_uint count;      // Slots claimed so far
+    atomic_uint generation; // Bumped by shutdown, so threads drop slots of an earlier registry
+#endif
+} registry;
+
+static void slot_publish_peak(Thread_Slot *slot) {
+    if (slot->arena && slot->arena->size > slot->peak_size) {
+        slot->peak_size = slot->arena->size;
+    }
+}
+
+void cab_thread_arenas_init(size_t block_size) {
+    registry.block_size = block_size ? block_size : CAB_ARENA_DEFAULT_BLOCK_SIZE;
+#if defined(CAB_SINGLE_THREADED)
+    registry.count = 0;
+#else
+    atomic_store(&registry.count, 0);
+#endif
+}
+
+static uint32_t registered_count() {
+#if defined(CAB_SINGLE_THREADED)
+    return registry.count;
+#else
+    uint32_t count = atomic_load_explicit(&registry.count, memory_order_acquire);
+    return count < CAB_MAX_THREADS ? count : CAB_MAX_THREADS;
+#endif
+}
+
+void cab_thread_arenas_shutdown() {
+    uint32_t count = registered_count();
+    for (uint32_t i = 0; i < count; i++) {
+        cab_arena_destroy(registry.slots[i].arena);
+        registry.slots[i] = (Thread_Slot){0};
+    }
+#if !defined(CAB_SINGLE_THREADED)
+    atomic_fetch_add(&registry.generation, 1);
+#endif
+    cab_thread_arenas_init(registry.block_size);
+}
+
+#if defined(CAB_SINGLE_THREADED)
+
+static Thread_Slot *current_slot() {
+    if (registry.count == 0) {
+        registry.slots[0].arena = cab_arena_create_growable_tagged(registry.block_size, CAB_MEM_TAG_THREADS);
+        registry.count = 1;
+    }
+    return &registry.slots[0];
+}
+
+#else
+
+static CAB_THREAD_LOCAL Thread_Slot *thread_slot;
+static CAB_THREAD_LOCAL uint32_t thread_generation;
+
+static Thread_Slot *current_slot() {
+    // A slot from before the last shutdown was zeroed and may now belong to another thread
+    uint32_t generation = atomic_load_explicit(&registry.generation, memory_order_relaxed);
+    if (thread_slot && thread_generation == generation) {
+        return thread_slot;
+    }
+    thread_slot = NULL;
+    thread_generation = generation;
+    uint32_t index = atomic_fetch_add(&registry.count, 1);
+    if (index >= CAB_MAX_THREADS) {
+        return NULL;
+    }
+    Thread_Slot *slot = &registry.slots[index];
+    slot->arena = cab_arena_create_growable_tagged(registry.block_size, CAB_MEM_TAG_THREADS);
+    thread_slot = slot;
+    return slot;
+}
+
+#endif
+
+Cab_Arena *cab_thread_arena() {
+    Thread_Slot *slot = current_slot();
+    return slot ? slot->arena : NULL;
+}
+
+uint32_t cab_thread_index() {
+    Thread_Slot *slot = current_slot();
+    return slot ? (uint32_t)(slot - registry.slots) : CAB_MAX_THREADS;
+}
+
+void cab_thread_publish(void *data, size_t size) {
+    Thread_Slot *slot = current_slot();
+    if (!slot) {
+        return;
+    }
+    Cab_Thread_Result *result = cab_arena_alloc(slot->arena, sizeof(Cab_Thread_Result));
+    if (!result) {
+        return;
+    }
+    *result = (Cab_Thread_Result){.data = data, .size = size};
+    if (slot->last_result) {
+        slot->last_result->next = result;
+    } else {
+        slot->results = result;
+    }
+    slot->last_result = result;
+}
+
+void cab_thread_arenas_collect(Cab_Thread_Result_Func func, void *user) {
+    uint32_t count = registered_count();
+    for (uint32_t i = 0; i < count; i++) {
+        for (Cab_Thread_Result *result = registry.slots[i].results; result; result = result->next) {
+            func(i, result->data, result->size, user);
+        }
+    }
+}
+
+void cab_thread_arenas_reset() {
+    uint32_t count = registered_count();
+    for (uint32_t i = 0; i < count; i++) {
+        Thread_Slot *slot = &registry.slots[i];
+        if (!slot->arena) {
+            continue;
+        }
+        slot_publish_peak(slot);
+        cab_arena_reset(slot->arena);
+        slot->results = NULL;
+        slot->last_result = NULL;
+    }
+}
+
+Cab_Thread_Arena_Stats cab_thread_arenas_stats() {
+    Cab_Thread_Arena_Stats stats = {0};
+    uint32_t count = registered_count();
+    for (uint32_t i = 0; i < count; i++) {
+        Thread_Slot *slot = &registry.slots[i];
+        if (!slot->arena) {
+            continue;
+        }
+        slot_publish_peak(slot);
+        stats.thread_count++;
+        stats.size += slot->arena->size;
+        stats.capacity += slot->arena->capacity;
+        stats.peak_size += slot->peak_size;
+    }
+    return stats;
+}
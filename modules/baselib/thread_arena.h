@@ -0,0 +1,55 @@
+#ifndef CAB_THREAD_ARENA_H
+#define CAB_THREAD_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+
+// Per-thread arenas. Every thread that calls cab_thread_arena() gets its own growable arena,
+// registered in a global registry so the main thread can collect results and reset them all at a
+// sync point, i.e. while no other thread is allocating. wasm builds without threads (and any build
+// defining CAB_SINGLE_THREADED) use a single arena and no atomics or thread-local storage.
+// Slots are never recycled, so this is meant for long-lived threads such as a worker pool.
+
+#if defined(CAB_SINGLE_THREADED)
+#define CAB_MAX_THREADS 1
+#else
+#define CAB_MAX_THREADS 64
+#endif
+
+// Result handed from a thread to the main thread, allocated in the publishing thread's arena
+typedef struct Cab_Thread_Result {
+    struct Cab_Thread_Result *next;
+    void *data;
+    size_t size;
+} Cab_Thread_Result;
+
+typedef void (*Cab_Thread_Result_Func)(uint32_t thread_index, void *data, size_t size, void *user);
+
+typedef struct Cab_Thread_Arena_Stats {
+    uint32_t thread_count;
+    size_t size;      // Bytes in use across all thread arenas
+    size_t capacity;  // Bytes owned across all thread arenas
+    size_t peak_size; // Sum of the largest size each thread arena reached
+} Cab_Thread_Arena_Stats;
+
+// Call once on the main thread before any other thread asks for an arena
+void cab_thread_arenas_init(size_t block_size);
+// Call once on the main thread after all other threads are done
+void cab_thread_arenas_shutdown();
+
+// Arena of the calling thread, registered on first use. Returns NULL once CAB_MAX_THREADS threads have registered
+Cab_Arena *cab_thread_arena();
+// Index of the calling thread in the registry, registering it on first use
+uint32_t cab_thread_index();
+// Hand data living in the calling thread's arena to the main thread. No locks are taken
+void cab_thread_publish(void *data, size_t size);
+
+// Sync point only: visit every published result, thread by thread in publish order
+void cab_thread_arenas_collect(Cab_Thread_Result_Func func, void *user);
+// Sync point only: drop published results and reset every thread arena, keeping their blocks
+void cab_thread_arenas_reset();
+// Sync point only: merged statistics across all thread arenas
+Cab_Thread_Arena_Stats cab_thread_arenas_stats();
+
+#endif // CAB_THREAD_ARENA_H
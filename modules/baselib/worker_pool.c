@@ -0,0 +1,307 @@
+#include "worker_pool.h"
+#include <stdbool.h>
+#include "mem_track.h"
+
+#if defined(CAB_SINGLE_THREADED)
+
+struct Cab_Worker_Pool {
+    uint32_t worker_count;
+};
+
+Cab_Worker_Pool *cab_worker_pool_create(uint32_t worker_count) {
+    (void)worker_count;
+    Cab_Worker_Pool *pool = (Cab_Worker_Pool *)cab_malloc(CAB_MEM_TAG_THREADS, sizeof(Cab_Worker_Pool));
+    if (pool) {
+        pool->worker_count = 0;
+    }
+    return pool;
+}
+
+void cab_worker_pool_destroy(Cab_Worker_Pool *pool) {
+    cab_free(pool);
+}
+
+uint32_t cab_worker_pool_thread_count(const Cab_Worker_Pool *pool) {
+    (void)pool;
+    return 1;
+}
+
+void cab_worker_pool_for(Cab_Worker_Pool *pool, uint32_t count, Cab_Parallel_Func func, void *user) {
+    (void)pool;
+    for (uint32_t i = 0; i < count; i++) {
+        func(i, user);
+    }
+}
+
+#else
+
+#include <stdatomic.h>
+
+// --- Platform threads ---
+
+#if defined(_WIN32)
+
+#include <windows.h>
+
+typedef HANDLE Thread;
+typedef SRWLOCK Mutex;
+typedef CONDITION_VARIABLE Cond;
+
+static DWORD WINAPI worker_main_win32(LPVOID arg);
+
+static bool thread_start(Thread *thread, void *arg) {
+    *thread = CreateThread(NULL, 0, worker_main_win32, arg, 0, NULL);
+    return *thread != NULL;
+}
+
+static void thread_join(Thread thread) {
+    WaitForSingleObject(thread, INFINITE);
+    CloseHandle(thread);
+}
+
+static void mutex_init(Mutex *mutex) {
+    InitializeSRWLock(mutex);
+}
+
+static void mutex_destroy(Mutex *mutex) {
+    (void)mutex;
+}
+
+static void mutex_lock(Mutex *mutex) {
+    AcquireSRWLockExclusive(mutex);
+}
+
+static void mutex_unlock(Mutex *mutex) {
+    ReleaseSRWLockExclusive(mutex);
+}
+
+static void cond_init(Cond *cond) {
+    InitializeConditionVariable(cond);
+}
+
+static void cond_destroy(Cond *cond) {
+    (void)cond;
+}
+
+static void cond_wait(Cond *cond, Mutex *mutex) {
+    SleepConditionVariableSRW(cond, mutex, INFINITE, 0);
+}
+
+static void cond_signal(Cond *cond) {
+    WakeConditionVariable(cond);
+}
+
+static void cond_broadcast(Cond *cond) {
+    WakeAllConditionVariable(cond);
+}
+
+static uint32_t core_count() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return (uint32_t)info.dwNumberOfProcessors;
+}
+
+#else
+
+#include <pthread.h>
+#include <unistd.h>
+
+typedef pthread_t Thread;
+typedef pthread_mutex_t Mutex;
+typedef pthread_cond_t Cond;
+
+static void *worker_main_posix(void *arg);
+
+static bool thread_start(Thread *thread, void *arg) {
+    return pthread_create(thread, NULL, worker_main_posix, arg) == 0;
+}
+
+static void thread_join(Thread thread) {
+    pthread_join(thread, NULL);
+}
+
+static void mutex_init(Mutex *mutex) {
+    pthread_mutex_init(mutex, NULL);
+}
+
+static void mutex_destroy(Mutex *mutex) {
+    pthread_mutex_destroy(mutex);
+}
+
+static void mutex_lock(Mutex *mutex) {
+    pthread_mutex_lock(mutex);
+}
+
+static void mutex_unlock(Mutex *mutex) {
+    pthread_mutex_unlock(mutex);
+}
+
+static void cond_init(Cond *cond) {
+    pthread_cond_init(cond, NULL);
+}
+
+static void cond_destroy(Cond *cond) {
+    pthread_cond_destroy(cond);
+}
+
+static void cond_wait(Cond *cond, Mutex *mutex) {
+    pthread_cond_wait(cond, mutex);
+}
+
+static void cond_signal(Cond *cond) {
+    pthread_cond_signal(cond);
+}
+
+static void cond_broadcast(Cond *cond) {
+    pthread_cond_broadcast(cond);
+}
+
+static uint32_t core_count() {
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+    return count > 0 ? (uint32_t)count : 1;
+}
+
+#endif
+
+// --- Pool ---
+
+struct Cab_Worker_Pool {
+    uint32_t worker_count;
+    Thread threads[CAB_MAX_THREADS];
+    Mutex mutex;
+    Cond wake;           // Signalled when a loop starts or the pool shuts down
+    Cond done;           // Signalled when the last worker leaves a loop
+    uint64_t generation; // Bumped for every loop, workers run each generation once
+    uint32_t busy;       // Workers still inside the current loop
+    bool shutdown;
+
+    // Current loop, written under the mutex before the generation is bumped
+    Cab_Parallel_Func func;
+    void *user;
+    uint32_t count;
+    atomic_uint next;    // Next index to hand out
+};
+
+// Indices are handed out one at a time, so uneven items balance across threads
+static void run_loop(Cab_Worker_Pool *pool) {
+    for (;;) {
+        uint32_t index = atomic_fetch_add_explicit(&pool->next, 1, memory_order_relaxed);
+        if (index >= pool->count) {
+            return;
+        }
+        pool->func(index, pool->user);
+    }
+}
+
+static void worker_main(Cab_Worker_Pool *pool) {
+    uint64_t seen = 0;
+    mutex_lock(&pool->mutex);
+    for (;;) {
+        while (pool->generation == seen && !pool->shutdown) {
+            cond_wait(&pool->wake, &pool->mutex);
+        }
+        if (pool->shutdown) {
+            break;
+        }
+        seen = pool->generation;
+        mutex_unlock(&pool->mutex);
+        run_loop(pool);
+        mutex_lock(&pool->mutex);
+        if (--pool->busy == 0) {
+            cond_signal(&pool->done);
+        }
+    }
+    mutex_unlock(&pool->mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI worker_main_win32(LPVOID arg) {
+    worker_main((Cab_Worker_Pool *)arg);
+    return 0;
+}
+#else
+static void *worker_main_posix(void *arg) {
+    worker_main((Cab_Worker_Pool *)arg);
+    return NULL;
+}
+#endif
+
+Cab_Worker_Pool *cab_worker_pool_create(uint32_t worker_count) {
+    if (worker_count == 0) {
+        uint32_t cores = core_count();
+        worker_count = cores > 1 ? cores - 1 : 0;
+    }
+    if (worker_count > CAB_MAX_THREADS - 1) {
+        worker_count = CAB_MAX_THREADS - 1;
+    }
+
+    Cab_Worker_Pool *pool = (Cab_Worker_Pool *)cab_calloc(CAB_MEM_TAG_THREADS, 1, sizeof(Cab_Worker_Pool));
+    if (!pool) {
+        return NULL;
+    }
+    mutex_init(&pool->mutex);
+    cond_init(&pool->wake);
+    cond_init(&pool->done);
+    atomic_init(&pool->next, 0);
+    for (uint32_t i = 0; i < worker_count; i++) {
+        if (!thread_start(&pool->threads[i], pool)) {
+            break; // Run with the workers that did start
+        }
+        pool->worker_count++;
+    }
+    return pool;
+}
+
+void cab_worker_pool_destroy(Cab_Worker_Pool *pool) {
+    if (!pool) {
+        return;
+    }
+    mutex_lock(&pool->mutex);
+    pool->shutdown = true;
+    cond_broadcast(&pool->wake);
+    mutex_unlock(&pool->mutex);
+    for (uint32_t i = 0; i < pool->worker_count; i++) {
+        thread_join(pool->threads[i]);
+    }
+    cond_destroy(&pool->done);
+    cond_destroy(&pool->wake);
+    mutex_destroy(&pool->mutex);
+    cab_free(pool);
+}
+
+uint32_t cab_worker_pool_thread_count(const Cab_Worker_Pool *pool) {
+    return pool->worker_count + 1;
+}
+
+void cab_worker_pool_for(Cab_Worker_Pool *pool, uint32_t count, Cab_Parallel_Func func, void *user) {
+    if (count == 0) {
+        return;
+    }
+    if (pool->worker_count == 0 || count == 1) {
+        for (uint32_t i = 0; i < count; i++) {
+            func(i, user);
+        }
+        return;
+    }
+
+    mutex_lock(&pool->mutex);
+    pool->func = func;
+    pool->user = user;
+    pool->count = count;
+    atomic_store_explicit(&pool->next, 0, memory_order_relaxed);
+    pool->busy = pool->worker_count;
+    pool->generation++;
+    cond_broadcast(&pool->wake);
+    mutex_unlock(&pool->mutex);
+
+    run_loop(pool);
+
+    // Taking the mutex after the last worker left also makes all of their writes visible here
+    mutex_lock(&pool->mutex);
+    while (pool->busy > 0) {
+        cond_wait(&pool->done, &pool->mutex);
+    }
+    mutex_unlock(&pool->mutex);
+}
+
+#endif
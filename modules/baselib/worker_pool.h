@@ -0,0 +1,29 @@
+#ifndef CAB_WORKER_POOL_H
+#define CAB_WORKER_POOL_H
+
+#include <stdint.h>
+#include "thread_arena.h"
+
+// Long-lived worker threads that run parallel for loops. The calling thread works on the loop
+// too and only returns once every index is done, so everything the loop wrote is visible to it
+// afterwards. Workers register with the thread arena registry like any other thread, so a
+// loop body can use cab_thread_arena() and cab_thread_publish(). Builds without threads
+// (CAB_SINGLE_THREADED) run every loop inline on the calling thread.
+
+typedef void (*Cab_Parallel_Func)(uint32_t index, void *user);
+
+typedef struct Cab_Worker_Pool Cab_Worker_Pool;
+
+// Starts worker_count threads besides the caller, 0 starts one per core minus the caller.
+// The count is capped so workers and the caller fit in CAB_MAX_THREADS registry slots
+Cab_Worker_Pool *cab_worker_pool_create(uint32_t worker_count);
+void cab_worker_pool_destroy(Cab_Worker_Pool *pool);
+
+// Threads working on a loop, including the caller
+uint32_t cab_worker_pool_thread_count(const Cab_Worker_Pool *pool);
+
+// Call func once for every index below count, in no particular order or thread. Only one
+// thread may run loops on a pool at a time
+void cab_worker_pool_for(Cab_Worker_Pool *pool, uint32_t count, Cab_Parallel_Func func, void *user);
+
+#endif // CAB_WORKER_POOL_H
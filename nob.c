@@ -12,6 +12,10 @@ const char *deps_dir = "deps";
 
 const char *build_dir = "build";
 
+// Shader headers are generated from *.glsl next to them by sokol-shdc, see compile_shaders
+const char *shader_slang = "glsl430:glsl300es:hlsl5";
+const char *shader_generated_marker = "Generated by sokol-shdc";
+
 // Helper struct to manage build targets (modules/demos)
 typedef struct {
     const char *name;         // Module or name (usually the directory name)
@@ -60,6 +64,9 @@ bool build_static_library(BuildTarget *target);
 bool build_executable(BuildTarget *target,
                         Nob_File_Paths *module_lib_paths);
 bool parse_module(const char *module_dir_path);
+bool find_files_recursive(const char *dir_path, const char *extension, Nob_File_Paths *result);
+const char *find_sokol_shdc();
+bool compile_shaders(const char *dir_path);
 bool rebuild();
 
 int main(int argc, char **argv) {
@@ -198,6 +205,10 @@ bool rebuild() {
         BuildTarget *demo = &demos.items[i];
         nob_log(NOB_INFO, "Building demo: %s", demo->name);
          if (!nob_mkdir_if_not_exists(demo->build_subdir)) return 1;
+        if (!compile_shaders(demo->dir_path)) {
+            nob_log(NOB_ERROR, "Failed to compile shaders for demo %s", demo->name);
+            return 1; // Abort build
+        }
 
         bool demo_ok = true;
         for (size_t j = 0; j < demo->src_files.count; ++j) {
@@ -256,6 +267,94 @@ bool parse_module(const char *module_dir_path) {
 
 
 
+// Find sokol-shdc, $SOKOL_SHDC wins over the PATH. Returns NULL when it is not installed
+const char *find_sokol_shdc() {
+    const char *override = getenv("SOKOL_SHDC");
+    if (override && *override) {
+        return override;
+    }
+    const char *path = getenv("PATH");
+    if (!path) {
+        return NULL;
+    }
+#ifdef _WIN32
+    const char separator = ';';
+    const char *exe_name = "sokol-shdc.exe";
+#else
+    const char separator = ':';
+    const char *exe_name = "sokol-shdc";
+#endif
+    Nob_String_View dirs = nob_sv_from_cstr(path);
+    while (dirs.count > 0) {
+        Nob_String_View dir = nob_sv_chop_by_delim(&dirs, separator);
+        if (dir.count == 0) {
+            continue;
+        }
+        const char *candidate = nob_temp_sprintf(SV_Fmt "/%s", SV_Arg(dir), exe_name);
+        if (nob_file_exists(candidate) == 1) {
+            return candidate;
+        }
+    }
+    return NULL;
+}
+
+// Regenerate every *.glsl.h in dir_path that is older than its *.glsl, or that was not written
+// by sokol-shdc at all. Without sokol-shdc the checked in headers are used with a warning
+bool compile_shaders(const char *dir_path) {
+    bool result = true;
+    Nob_File_Paths shaders = {0};
+    Nob_String_Builder header = {0};
+    Nob_Cmd cmd = {0};
+    const char *shdc = NULL;
+    bool shdc_searched = false;
+
+    if (!find_files_recursive(dir_path, ".glsl", &shaders)) {
+        nob_return_defer(false);
+    }
+    for (size_t i = 0; i < shaders.count; ++i) {
+        const char *src_path = shaders.items[i];
+        const char *header_path = nob_temp_sprintf("%s.h", src_path);
+
+        int stale = nob_file_exists(header_path) == 1 ? nob_needs_rebuild1(header_path, src_path) : 1;
+        if (stale < 0) {
+            nob_return_defer(false);
+        }
+        if (stale == 0) {
+            header.count = 0;
+            if (!nob_read_entire_file(header_path, &header)) {
+                nob_return_defer(false);
+            }
+            nob_sb_append_null(&header);
+            stale = strstr(header.items, shader_generated_marker) == NULL;
+        }
+        if (!stale) {
+            nob_log(NOB_INFO, "Shader header %s is up to date.", header_path);
+            continue;
+        }
+
+        if (!shdc_searched) {
+            shdc = find_sokol_shdc();
+            shdc_searched = true;
+        }
+        if (!shdc) {
+            nob_log(NOB_WARNING, "sokol-shdc not found, %s was not regenerated from %s", header_path, src_path);
+            continue;
+        }
+        nob_log(NOB_INFO, "Generating %s -> %s", src_path, header_path);
+        nob_cmd_append(&cmd, shdc, "--input", src_path, "--output", header_path, "--slang", shader_slang);
+        if (!nob_cmd_run_sync_and_reset(&cmd)) {
+            nob_log(NOB_ERROR, "Failed to generate %s", header_path);
+            nob_return_defer(false);
+        }
+    }
+
+defer:
+    nob_cmd_free(cmd);
+    nob_sb_free(header);
+    nob_da_free(shaders);
+    return result;
+}
+
 // Recursively find files with a specific extension in a directory
 bool find_files_recursive(const char *dir_path, const char *extension, Nob_File_Paths *result) {
     bool success = true;